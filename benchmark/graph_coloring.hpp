@@ -0,0 +1,576 @@
+#ifndef _benchmark_graph_coloring_included_
+#define _benchmark_graph_coloring_included_
+
+#include "probe.hpp"
+#include "runner.hpp"
+#include "../localsearch/algorithm/annealing_search.hpp"
+#include "../localsearch/algorithm/checkpoint.hpp"
+#include "../localsearch/algorithm/late_acceptance_search.hpp"
+#include "../localsearch/algorithm/rna_search.hpp"
+#include "../localsearch/algorithm/segmented_array.hpp"
+#include "../localsearch/algorithm/tabu_search.hpp"
+#include "../localsearch/algorithm/zobrist_table.hpp"
+#include "../localsearch/factory.hpp"
+#include "../localsearch/interface/isolution.h"
+#include "../localsearch/interface/istep.h"
+#include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+//Graph coloring: assign one of k colors to each vertex of a random graph, minimizing the number of edges with both ends of the same color.
+namespace Benchmark::GraphColoring {
+
+	//random graph G(n, p)
+	struct Instance {
+
+		Instance(const boost::property_tree::ptree &pt)
+		:
+			vertices{pt.get<int>("vertices")},
+			colors{pt.get<int>("colors")},
+			adjacent(vertices),
+			zobrist{vertices, colors, pt.get<unsigned>("seed")}
+		{
+			std::mt19937 random{pt.get<unsigned>("seed")};
+			std::bernoulli_distribution edge{pt.get<double>("density")};
+			for (int u = 0; u < vertices; ++u) {
+				for (int v = u + 1; v < vertices; ++v) {
+					if (edge(random)) {
+						adjacent[u].push_back(v);
+						adjacent[v].push_back(u);
+					}
+				}
+			}
+		}
+
+		int vertices;
+		int colors;
+		std::vector<std::vector<int>> adjacent;
+		Algorithm::ZobristTable zobrist; //keys of the vertex colors, for hashing the solutions
+	};
+
+	class Solution final : public Algorithm::ISolution {
+
+	  public:
+
+		Solution(std::shared_ptr<const Instance> instance, unsigned seed)
+		:
+			_instance{std::move(instance)},
+			_color(_instance->vertices),
+			_conflicts(_instance->vertices * _instance->colors, 0)
+		{
+			std::mt19937 random{seed};
+			std::uniform_int_distribution<int> color{0, _instance->colors - 1};
+			for (int v = 0; v < _instance->vertices; ++v)
+				_color.set(v, color(random));
+
+			markDirty();
+		}
+
+		Solution(const Solution &other)
+		:
+			_instance{other._instance},
+			_color{other._color},
+			_conflicts{other._conflicts},
+			_fitness{other._fitness},
+			_hash{other._hash}
+		{
+		}
+
+		Solution &operator=(const Solution &other)
+		{
+			_instance = other._instance;
+			_color = other._color;
+			_conflicts = other._conflicts;
+			_fitness = other._fitness;
+			_hash = other._hash;
+			return *this;
+		}
+
+		bool operator==(const Solution &other) const noexcept { return _color == other._color; }
+
+		//Zobrist hash of the coloring, kept up to date by recoloring
+		std::uint64_t hash() const noexcept { return _hash; }
+
+		bool normalize() noexcept final { return false; }
+		Algorithm::Fitness getFitness() noexcept final { return Algorithm::Fitness{_fitness}; }
+		bool isFeasible() noexcept final { return _fitness == 0; }
+
+		void markDirty() final
+		{
+			_conflicts.fill(0);
+			_fitness = 0;
+			_hash = 0;
+			for (int u = 0; u < _instance->vertices; ++u) {
+				_hash ^= _instance->zobrist.key(u, _color[u]);
+				for (int v : _instance->adjacent[u]) {
+					_conflicts.mutate(u * _instance->colors + _color[v])++;
+					if (u < v && _color[u] == _color[v])
+						_fitness++;
+				}
+			}
+		}
+
+		void load(const boost::property_tree::ptree &pt) final
+		{
+			std::istringstream in{pt.get<std::string>("colors")};
+			for (int v = 0; v < _instance->vertices; ++v)
+				in >> _color.mutate(v);
+
+			markDirty();
+		}
+
+		void save(boost::property_tree::ptree &pt) final
+		{
+			std::as_const(*this).save(pt);
+		}
+
+		void save(boost::property_tree::ptree &pt) const final
+		{
+			std::ostringstream out;
+			for (int c : _color)
+				out << c << ' ';
+
+			pt.put("colors", out.str());
+		}
+
+		//binary form for checkpoints
+		void save(Algorithm::Checkpoint::Writer &out) const
+		{
+			out.write(std::vector<int>(_color.begin(), _color.end()));
+		}
+
+		void load(Algorithm::Checkpoint::Reader &in)
+		{
+			std::vector<int> colors;
+			in.read(colors);
+			_color.assign(colors.size(), 0);
+			for (std::size_t v = 0; v < colors.size(); ++v)
+				_color.set(v, colors[v]);
+
+			markDirty();
+		}
+
+		const Instance &instance() const noexcept { return *_instance; }
+		int color(int vertex) const noexcept { return _color[vertex]; }
+
+		//number of neighbors of the vertex having the color
+		int conflicts(int vertex, int color) const noexcept { return _conflicts[vertex * _instance->colors + color]; }
+
+		//change of fitness if the vertex was recolored
+		int delta(int vertex, int color) const noexcept { return conflicts(vertex, color) - conflicts(vertex, _color[vertex]); }
+
+		void recolor(int vertex, int color) noexcept
+		{
+			_fitness += delta(vertex, color);
+			for (int v : _instance->adjacent[vertex]) {
+				_conflicts.mutate(v * _instance->colors + _color[vertex])--;
+				_conflicts.mutate(v * _instance->colors + color)++;
+			}
+			_hash ^= _instance->zobrist.change(vertex, _color[vertex], color);
+			_color.set(vertex, color);
+			Probe::fitness(getFitness());
+		}
+
+	  private:
+
+		std::shared_ptr<const Instance> _instance;
+		//copy-on-write, so that the copies kept by the searchers share the parts that didn't change
+		Algorithm::SegmentedArray<int> _color;
+		Algorithm::SegmentedArray<int> _conflicts; //number of neighbors of each vertex having each color (vertices x colors)
+		int _fitness{0};
+		std::uint64_t _hash{0};
+	};
+
+	class Step final : public Algorithm::IStep<Solution> {
+
+	  public:
+
+		Step(const Solution &solution, int vertex, int color) noexcept
+		:
+			_vertex{vertex},
+			_from{solution.color(vertex)},
+			_to{color},
+			_delta{solution.delta(vertex, color)}
+		{
+		}
+
+		Algorithm::AdaptedFitness::delta_t adaptedDelta() const noexcept final { return _delta; }
+		Algorithm::Fitness::delta_t delta() const noexcept final { return _delta; }
+
+		void execute(Solution &solution) const final
+		{
+			Probe::step();
+			solution.recolor(_vertex, _to);
+		}
+
+		void undo(Solution &solution) const
+		{
+			solution.recolor(_vertex, _from);
+		}
+
+		void dump(std::ostream &out) const final
+		{
+			out << "vertex " << _vertex << ": " << _from << " -> " << _to;
+		}
+
+		//tabu list interface
+		bool isUndoOf(const Step &other) const noexcept { return _vertex == other._vertex && _to == other._from; }
+		bool isEqualForShortTermTabu(const Step &other) const noexcept { return _vertex == other._vertex; }
+
+		//move cache interface, regions are the vertices, whose steps depend on the colors of their neighbors
+		void touchedRegions(const Solution &solution, std::vector<int> &regions) const
+		{
+			regions.push_back(_vertex);
+			auto const &adjacent = solution.instance().adjacent[_vertex];
+			regions.insert(regions.end(), adjacent.begin(), adjacent.end());
+		}
+
+	  private:
+
+		int _vertex;
+		int _from;
+		int _to;
+		int _delta;
+	};
+
+	//Recolors a conflicting vertex to the best color.
+	//The vertices are split into partitions, which can be evaluated in parallel.
+	class TabuSearcher final : public Algorithm::TabuSearch::Searcher<Solution, Step> {
+
+	  public:
+
+		using Algorithm::TabuSearch::Searcher<Solution, Step>::Searcher;
+
+		const std::string &name() const noexcept final { return _name; }
+
+	  private:
+
+		static constexpr int _partitionSize{64};
+
+		int _getPartitionCount(Solution &solution) const final
+		{
+			return (solution.instance().vertices + _partitionSize - 1) / _partitionSize;
+		}
+
+		void _evaluatePartition(Solution &solution, int partition, Candidates &candidates) const final
+		{
+			auto const &instance = solution.instance();
+			const int last{std::min(instance.vertices, (partition + 1) * _partitionSize)};
+			for (int vertex = partition * _partitionSize; vertex < last; ++vertex) {
+				if (solution.conflicts(vertex, solution.color(vertex)) == 0)
+					continue;
+
+				for (int color = 0; color < instance.colors; ++color) {
+					if (color != solution.color(vertex) && candidates.isCompetitive(solution.delta(vertex, color)))
+						candidates.offer(makeStep(solution, vertex, color));
+				}
+			}
+		}
+
+		static inline const std::string _name{"Graph coloring tabu search"};
+	};
+
+	//Same as the tabu searcher, but with a partition for each vertex, so that the move cache can keep the steps of the vertices
+	//not adjacent to the last recolored one.
+	class CachedTabuSearcher final : public Algorithm::TabuSearch::Searcher<Solution, Step> {
+
+	  public:
+
+		using Algorithm::TabuSearch::Searcher<Solution, Step>::Searcher;
+
+		const std::string &name() const noexcept final { return _name; }
+
+	  private:
+
+		int _getPartitionCount(Solution &solution) const final
+		{
+			return solution.instance().vertices;
+		}
+
+		void _evaluatePartition(Solution &solution, int vertex, Candidates &candidates) const final
+		{
+			if (solution.conflicts(vertex, solution.color(vertex)) == 0)
+				return;
+
+			for (int color = 0; color < solution.instance().colors; ++color) {
+				if (color != solution.color(vertex) && candidates.isCompetitive(solution.delta(vertex, color)))
+					candidates.offer(makeStep(solution, vertex, color));
+			}
+		}
+
+		static inline const std::string _name{"Graph coloring cached tabu search"};
+	};
+
+	//recolors a random vertex to a random color if it doesn't make things worse
+	class RnaSearcher final : public Algorithm::RNA::Searcher<Solution> {
+
+	  public:
+
+		using Algorithm::RNA::Searcher<Solution>::Searcher;
+
+		const std::string &name() const noexcept final { return _name; }
+
+	  private:
+
+		Algorithm::Fitness::delta_t _walk(Solution &solution) const final
+		{
+			Probe::step();
+			auto const &instance = solution.instance();
+			const int vertex{static_cast<int>(_random().below(instance.vertices))};
+			const int color{static_cast<int>(_random().below(instance.colors))};
+			const int delta{solution.delta(vertex, color)};
+			if (delta > 0)
+				return 0;
+
+			solution.recolor(vertex, color);
+			return delta;
+		}
+
+		static inline const std::string _name{"Graph coloring RNA search"};
+	};
+
+	//proposes random recolorings, which the RNA search evaluates in batches; they are too cheap to pay for threads
+	class BatchedRnaSearcher final : public Algorithm::RNA::StaticSearcher<BatchedRnaSearcher, Solution> {
+
+		friend Algorithm::RNA::StaticSearcher<BatchedRnaSearcher, Solution>;
+
+	  public:
+
+		using Algorithm::RNA::StaticSearcher<BatchedRnaSearcher, Solution>::StaticSearcher;
+
+		const std::string &name() const noexcept final { return _name; }
+
+	  private:
+
+		struct Proposal {
+			int vertex;
+			int color;
+		};
+
+		Algorithm::Fitness::delta_t _propose(const Solution &solution, Algorithm::Private::FastRandom &random, Proposal &proposal) const
+		{
+			Probe::step();
+			auto const &instance = solution.instance();
+			proposal.vertex = static_cast<int>(random.below(instance.vertices));
+			proposal.color = static_cast<int>(random.below(instance.colors));
+			return solution.delta(proposal.vertex, proposal.color);
+		}
+
+		void _apply(Solution &solution, const Proposal &proposal) const
+		{
+			solution.recolor(proposal.vertex, proposal.color);
+		}
+
+		static inline const std::string _name{"Graph coloring batched RNA search"};
+	};
+
+	//recolors a random vertex to a random color if the annealing accepts it
+	class AnnealingSearcher final : public Algorithm::Annealing::Searcher<Solution> {
+
+	  public:
+
+		using Algorithm::Annealing::Searcher<Solution>::Searcher;
+
+		const std::string &name() const noexcept final { return _name; }
+
+	  private:
+
+		Algorithm::Fitness::delta_t _walk(Solution &solution, Algorithm::Fitness::delta_t maxDelta) const final
+		{
+			Probe::step();
+			auto const &instance = solution.instance();
+			const int vertex{static_cast<int>(_random().below(instance.vertices))};
+			const int color{static_cast<int>(_random().below(instance.colors))};
+			const int delta{solution.delta(vertex, color)};
+			if (delta > maxDelta)
+				return 0;
+
+			solution.recolor(vertex, color);
+			return delta;
+		}
+
+		static inline const std::string _name{"Graph coloring annealing search"};
+	};
+
+	//recolors a random vertex to a random color if the late acceptance allows it
+	class LateAcceptanceSearcher final : public Algorithm::LateAcceptance::Searcher<Solution> {
+
+	  public:
+
+		using Algorithm::LateAcceptance::Searcher<Solution>::Searcher;
+
+		const std::string &name() const noexcept final { return _name; }
+
+	  private:
+
+		Algorithm::Fitness::delta_t _walk(Solution &solution, Algorithm::Fitness::delta_t maxDelta) const final
+		{
+			Probe::step();
+			auto const &instance = solution.instance();
+			const int vertex{static_cast<int>(_random().below(instance.vertices))};
+			const int color{static_cast<int>(_random().below(instance.colors))};
+			const int delta{solution.delta(vertex, color)};
+			if (delta > maxDelta)
+				return 0;
+
+			solution.recolor(vertex, color);
+			return delta;
+		}
+
+		static inline const std::string _name{"Graph coloring late acceptance search"};
+	};
+
+	inline void run(Runner &runner)
+	{
+		[[maybe_unused]] static const bool registered = [] {
+			auto &factory = Algorithm::SingleFactory<Solution>::Instance();
+			factory.registerAlgorithm("tabu", [](const boost::property_tree::ptree &pt) { return std::make_unique<TabuSearcher>(pt); });
+			factory.registerAlgorithm("tabu-cached", [](const boost::property_tree::ptree &pt) { return std::make_unique<CachedTabuSearcher>(pt); });
+			factory.registerAlgorithm("rna", [](const boost::property_tree::ptree &pt) { return std::make_unique<RnaSearcher>(pt); });
+			factory.registerAlgorithm("rna-batched", [](const boost::property_tree::ptree &pt) { return std::make_unique<BatchedRnaSearcher>(pt); });
+			factory.registerAlgorithm("annealing", [](const boost::property_tree::ptree &pt) { return std::make_unique<AnnealingSearcher>(pt); });
+			factory.registerAlgorithm("lahc", [](const boost::property_tree::ptree &pt) { return std::make_unique<LateAcceptanceSearcher>(pt); });
+			return true;
+		}();
+
+		auto const createSolution = [](const boost::property_tree::ptree &pt) {
+			return std::make_unique<Solution>(std::make_shared<const Instance>(pt), pt.get<unsigned>("seed"));
+		};
+
+		runner.run<Solution>("coloring", R"({
+			"name": "tabu",
+			"instance": {"vertices": 250, "density": 0.1, "colors": 8, "seed": 1},
+			"target": 3,
+			"search": {
+				"benchmark": true, "repeat": 1, "cycles": 4,
+				"algorithms": [
+					{"name": "tabu", "config": {"maxSteps": 5000}}
+				]
+			}
+		})", createSolution);
+
+		//on a large sparse graph, recoloring a vertex changes the steps of few others, which is where the move cache pays off
+		//(same searcher and partitions in both cases, so they walk the same trajectory)
+		runner.run<Solution>("coloring", R"({
+			"name": "tabu-sparse",
+			"instance": {"vertices": 2000, "density": 0.01, "colors": 6, "seed": 1},
+			"target": 250,
+			"search": {
+				"benchmark": true, "repeat": 1, "cycles": 1,
+				"algorithms": [
+					{"name": "tabu-cached", "config": {"maxSteps": 2000}}
+				]
+			}
+		})", createSolution);
+
+		runner.run<Solution>("coloring", R"({
+			"name": "tabu-sparse-cached",
+			"instance": {"vertices": 2000, "density": 0.01, "colors": 6, "seed": 1},
+			"target": 250,
+			"search": {
+				"benchmark": true, "repeat": 1, "cycles": 1,
+				"algorithms": [
+					{"name": "tabu-cached", "config": {"maxSteps": 2000, "moveCache": true}}
+				]
+			}
+		})", createSolution);
+
+		runner.run<Solution>("coloring", R"({
+			"name": "tabu-sparse-sampled",
+			"instance": {"vertices": 2000, "density": 0.01, "colors": 6, "seed": 1},
+			"target": 250,
+			"search": {
+				"benchmark": true, "repeat": 1, "cycles": 1,
+				"algorithms": [
+					{"name": "tabu-cached", "config": {"maxSteps": 2000, "candidateList": "sampled", "sampleSize": 200}}
+				]
+			}
+		})", createSolution);
+
+		runner.run<Solution>("coloring", R"({
+			"name": "tabu-sparse-elite",
+			"instance": {"vertices": 2000, "density": 0.01, "colors": 6, "seed": 1},
+			"target": 250,
+			"search": {
+				"benchmark": true, "repeat": 1, "cycles": 1,
+				"algorithms": [
+					{"name": "tabu-cached", "config": {"maxSteps": 2000, "candidateList": "elite", "eliteSize": 200, "eliteRefresh": 10}}
+				]
+			}
+		})", createSolution);
+
+		runner.run<Solution>("coloring", R"({
+			"name": "rna+tabu",
+			"instance": {"vertices": 250, "density": 0.1, "colors": 8, "seed": 1},
+			"target": 0,
+			"search": {
+				"benchmark": true, "repeat": 1, "cycles": 4,
+				"algorithms": [
+					{"name": "rna", "config": {"maxSteps": 20000}},
+					{"name": "tabu", "config": {"maxSteps": 5000}}
+				]
+			}
+		})", createSolution);
+
+		runner.run<Solution>("coloring", R"({
+			"name": "rna-batched+tabu",
+			"instance": {"vertices": 250, "density": 0.1, "colors": 8, "seed": 1},
+			"target": 1,
+			"search": {
+				"benchmark": true, "repeat": 1, "cycles": 4,
+				"algorithms": [
+					{"name": "rna-batched", "config": {"maxSteps": 20000, "proposals": 8}},
+					{"name": "tabu", "config": {"maxSteps": 5000}}
+				]
+			}
+		})", createSolution);
+
+		runner.run<Solution>("coloring", R"({
+			"name": "annealing+tabu",
+			"instance": {"vertices": 250, "density": 0.1, "colors": 8, "seed": 1},
+			"target": 2,
+			"search": {
+				"benchmark": true, "repeat": 1, "cycles": 4,
+				"algorithms": [
+					{"name": "annealing", "config": {"maxSteps": 500000, "initialTemperature": 1, "finalTemperature": 0.1}},
+					{"name": "tabu", "config": {"maxSteps": 5000}}
+				]
+			}
+		})", createSolution);
+
+		runner.run<Solution>("coloring", R"({
+			"name": "lahc+tabu",
+			"instance": {"vertices": 250, "density": 0.1, "colors": 8, "seed": 1},
+			"target": 0,
+			"search": {
+				"benchmark": true, "repeat": 1, "cycles": 4,
+				"algorithms": [
+					{"name": "lahc", "config": {"historyLength": 5000}},
+					{"name": "tabu", "config": {"maxSteps": 5000}}
+				]
+			}
+		})", createSolution);
+
+		runner.run<Solution>("coloring", R"({
+			"name": "tabu-parallel",
+			"instance": {"vertices": 500, "density": 0.1, "colors": 13, "seed": 2},
+			"target": 2,
+			"search": {
+				"benchmark": true, "repeat": 1, "cycles": 4,
+				"algorithms": [
+					{"name": "tabu", "config": {"maxSteps": 5000, "threads": 4}}
+				]
+			}
+		})", createSolution);
+	}
+
+} //ns Benchmark::GraphColoring
+
+#endif //file guard
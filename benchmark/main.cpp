@@ -0,0 +1,37 @@
+//Benchmark of the local search framework on synthetic reference problems.
+//Usage: benchmark [filter] [output file]
+//Runs the cases with the filter in their "problem/name" identifier (all cases by default)
+//and writes one line of JSON per case to the output file (standard output by default).
+#include "graph_coloring.hpp"
+#include "qap.hpp"
+#include "runner.hpp"
+#include "timetabling.hpp"
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char *argv[])
+{
+	const std::string filter{argc > 1 ? argv[1] : ""};
+	std::ofstream file;
+	if (argc > 2) {
+		file.open(argv[2]);
+		if (!file) {
+			std::cerr << "Cannot open " << argv[2] << std::endl;
+			return 1;
+		}
+	}
+
+	try {
+		Benchmark::Runner runner{argc > 2 ? file : std::cout, filter};
+		Benchmark::GraphColoring::run(runner);
+		Benchmark::QAP::run(runner);
+		Benchmark::Timetabling::run(runner);
+	}
+	catch (const std::exception &e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
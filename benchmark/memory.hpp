@@ -0,0 +1,44 @@
+#ifndef _benchmark_memory_included_
+#define _benchmark_memory_included_
+
+#include <cstdint>
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+	#include <psapi.h>
+	#pragma comment(lib, "psapi.lib")
+#else
+	#include <sys/resource.h>
+#endif
+
+namespace Benchmark {
+
+	//Peak resident memory of the process in kilobytes, zero if unknown.
+	//It never decreases, run a single case per process to get the peak of that case.
+	inline std::int64_t peakMemoryKB() noexcept
+	{
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS counters;
+		if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+			return 0;
+
+		return static_cast<std::int64_t>(counters.PeakWorkingSetSize / 1024);
+#else
+		rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage) != 0)
+			return 0;
+
+	#ifdef __APPLE__
+		return usage.ru_maxrss / 1024; //bytes on macOS
+	#else
+		return usage.ru_maxrss;
+	#endif
+#endif
+	}
+
+} //ns Benchmark
+
+#endif //file guard
@@ -0,0 +1,419 @@
+//Microbenchmarks of the framework's own primitives, to tell framework overhead from problem code and to catch regressions in them.
+//Usage: microbenchmark [filter] [output file]
+//Runs the benchmarks with the filter in their name (all by default)
+//and writes one line of JSON per benchmark to the output file (standard output by default).
+#include "graph_coloring.hpp"
+#include "../localsearch/algorithm/hashed_tabu_list.hpp"
+#include "../localsearch/algorithm/random.hpp"
+#include "../localsearch/algorithm/tabu_list.hpp"
+#include "../localsearch/algorithm/visited_set.hpp"
+#include "../localsearch/events/async_dispatcher.hpp"
+#include "../localsearch/events/audience.h"
+#include "../localsearch/events/events.h"
+#include "../localsearch/factory.hpp"
+#include "../localsearch/fitness.hpp"
+#include "../localsearch/interface/ialgorithm.h"
+#include <ctoolhu/event/firer.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Benchmark::Micro {
+
+	//Runs the operation in batches until the minimum time is spent and reports the average time of one call.
+	class Runner {
+
+	  public:
+
+		Runner(std::ostream &out, std::string filter)
+		:
+			_out{out},
+			_filter{std::move(filter)}
+		{
+		}
+
+		template <class Operation>
+		void run(const std::string &name, Operation &&operation)
+		{
+			if (name.find(_filter) == std::string::npos)
+				return;
+
+			using clock_t = std::chrono::steady_clock;
+			constexpr std::chrono::milliseconds minTime{200};
+
+			for (int i = 0; i < _batch; ++i) //warm-up
+				operation();
+
+			std::int64_t calls{0};
+			const auto started = clock_t::now();
+			auto elapsed = clock_t::duration::zero();
+			while (elapsed < minTime) {
+				for (int i = 0; i < _batch; ++i)
+					operation();
+
+				calls += _batch;
+				elapsed = clock_t::now() - started;
+			}
+
+			const double ns{static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count())};
+			_out << "{\"benchmark\": \"" << name << "\", \"calls\": " << calls << ", \"nsPerCall\": " << ns / calls << "}" << std::endl;
+		}
+
+	  private:
+
+		static constexpr int _batch{1000};
+
+		std::ostream &_out;
+		std::string _filter;
+	};
+
+	//keeps the compiler from optimizing away results of the measured operations
+	inline volatile std::uintptr_t sink;
+
+	template <class T>
+	void keep(const T &value) noexcept
+	{
+		sink = sink + static_cast<std::uintptr_t>(value);
+	}
+
+	//step with both the pairwise and hashed tabu interfaces, about as cheap to compare as real steps get
+	struct Step {
+
+		bool isUndoOf(const Step &other) const noexcept { return item == other.item && to == other.from; }
+		bool isEqualForShortTermTabu(const Step &other) const noexcept { return item == other.item; }
+		std::size_t tabuKey() const noexcept { return item * 64 + to; }
+		std::size_t undoKey() const noexcept { return item * 64 + from; }
+
+		int item;
+		int from;
+		int to;
+	};
+
+	using step_ptr_t = std::shared_ptr<Step>;
+
+	std::vector<step_ptr_t> makeSteps(int count)
+	{
+		std::mt19937 random{1};
+		std::uniform_int_distribution<int> item{0, 999}, value{0, 63};
+		std::vector<step_ptr_t> steps;
+		for (int i = 0; i < count; ++i)
+			steps.push_back(std::make_shared<Step>(Step{item(random), value(random), value(random)}));
+
+		return steps;
+	}
+
+	//Tabu list operations at steady state, i.e. with the list as long as the tenure makes it.
+	//Each insert is followed by a shift, as in the tabu search.
+	template <template <class> class TabuListPolicy>
+	void tabuList(Runner &runner, const std::string &policy)
+	{
+		const auto steps = makeSteps(4096);
+		for (auto [lower, upper] : {std::pair{5, 10}, std::pair{20, 30}, std::pair{100, 150}}) {
+			boost::property_tree::ptree pt;
+			pt.put("tabuLower", lower);
+			pt.put("tabuUpper", upper);
+			Algorithm::Private::FastRandom random{1};
+			TabuListPolicy<Step> list{pt, random};
+			std::size_t next{0};
+			auto const insertAndShift = [&] {
+				list.insert(steps[next++ % steps.size()]);
+				list.shift();
+			};
+			for (int i = 0; i < upper; ++i)
+				insertAndShift();
+
+			const std::string tenure{std::to_string(lower) + "-" + std::to_string(upper)};
+			runner.run(policy + "/insert+shift/tenure " + tenure, insertAndShift);
+			runner.run(policy + "/isTabu/tenure " + tenure, [&] {
+				keep(list.isTabu(*steps[next++ % steps.size()]));
+			});
+		}
+	}
+
+	//Recognizing a return to a solution of the tabu search, by comparing the structure with the best solution,
+	//or by looking up the hash among the recently visited solutions.
+	void cycleCheck(Runner &runner)
+	{
+		boost::property_tree::ptree pt;
+		pt.put("vertices", 2000);
+		pt.put("density", 0.01);
+		pt.put("colors", 6);
+		pt.put("seed", 1);
+		auto const instance = std::make_shared<const GraphColoring::Instance>(pt);
+		GraphColoring::Solution solution{instance, 1};
+		const GraphColoring::Solution best{solution};
+		solution.recolor(1999, (solution.color(1999) + 1) % instance->colors); //differs at the end, so that the comparison is the worst case
+		runner.run("cycleCheck/compare with best (coloring 2000)", [&] {
+			keep(solution == best);
+		});
+
+		Algorithm::TabuSearch::VisitedSet visited{1000};
+		Algorithm::Private::FastRandom random{1};
+		int step{0};
+		runner.run("cycleCheck/visited set, limit 1000", [&] {
+			keep(visited.visit(random.below(4096), step++));
+		});
+	}
+
+	//Copying the current solution over the best one after a step, as the searchers do when the best solution improves.
+	//The coloring keeps its arrays copy-on-write, so only the segments touched by the step are copied,
+	//compared to copying the same amount of data in plain vectors.
+	void solutionCopy(Runner &runner)
+	{
+		boost::property_tree::ptree pt;
+		pt.put("vertices", 10000);
+		pt.put("density", 0.001);
+		pt.put("colors", 6);
+		pt.put("seed", 1);
+		auto const instance = std::make_shared<const GraphColoring::Instance>(pt);
+		GraphColoring::Solution solution{instance, 1};
+		GraphColoring::Solution best{solution};
+		int vertex{0};
+		runner.run("solutionCopy/recolor + copy to best (coloring 10000, segmented)", [&] {
+			solution.recolor(vertex, (solution.color(vertex) + 1) % instance->colors);
+			vertex = (vertex + 1) % instance->vertices;
+			best = solution;
+		});
+
+		std::vector<int> color(instance->vertices), conflicts(instance->vertices * instance->colors);
+		std::vector<int> bestColor{color}, bestConflicts{conflicts};
+		runner.run("solutionCopy/copy of the same data in vectors", [&] {
+			color[vertex]++;
+			vertex = (vertex + 1) % instance->vertices;
+			bestColor = color;
+			bestConflicts = conflicts;
+			keep(bestColor.front());
+		});
+	}
+
+	//the per-instance engine of the searchers compared to the standard one
+	void random(Runner &runner)
+	{
+		Algorithm::Private::FastRandom fast{1};
+		std::mt19937 standard{1};
+		int bound{1};
+		runner.run("random/FastRandom below", [&] {
+			keep(fast.below(static_cast<std::uint32_t>(bound)));
+			bound = bound % 1000 + 1;
+		});
+		runner.run("random/mt19937 uniform_int_distribution", [&] {
+			keep(std::uniform_int_distribution<int>{0, bound - 1}(standard));
+			bound = bound % 1000 + 1;
+		});
+	}
+
+	void fitness(Runner &runner)
+	{
+		Algorithm::Fitness fitness{1000000};
+		int delta{1};
+		runner.run("fitness/add delta", [&] {
+			fitness = fitness + delta;
+			delta = -delta;
+			keep(fitness.isZero());
+		});
+		runner.run("fitness/difference", [&] {
+			const Algorithm::Fitness other{fitness + delta};
+			keep(other - fitness);
+			delta = -delta;
+		});
+		runner.run("fitness/compare", [&] {
+			const Algorithm::Fitness other{fitness + delta};
+			keep(other < fitness);
+			delta = -delta;
+		});
+	}
+
+	void factory(Runner &runner)
+	{
+		using GraphColoring::Solution;
+		Algorithm::SingleFactory<Solution>::Instance().registerAlgorithm("rna", [](const boost::property_tree::ptree &pt) {
+			return std::make_unique<GraphColoring::RnaSearcher>(pt);
+		});
+		Algorithm::SingleFactory<Solution>::Instance().registerAlgorithm("tabu", [](const boost::property_tree::ptree &pt) {
+			return std::make_unique<GraphColoring::TabuSearcher>(pt);
+		});
+
+		boost::property_tree::ptree pt;
+		pt.put("maxSteps", 1000);
+		pt.put("keepFeasible", true);
+		runner.run("factory/createAlgorithm rna", [&] {
+			keep(Algorithm::SingleFactory<Solution>::Instance().createAlgorithm("rna", pt, nullptr) != nullptr);
+		});
+		runner.run("factory/createAlgorithm tabu", [&] {
+			keep(Algorithm::SingleFactory<Solution>::Instance().createAlgorithm("tabu", pt, nullptr) != nullptr);
+		});
+		runner.run("factory/createAlgorithm unknown", [&] {
+			keep(Algorithm::SingleFactory<Solution>::Instance().createAlgorithm("unknown", pt, nullptr) != nullptr);
+		});
+	}
+
+	struct UnheardEvent {
+		int value;
+	};
+
+	struct HeardEvent {
+		int value;
+	};
+
+	//does next to nothing with the event, so that only the dispatch to it is measured
+	template <class Event>
+	class TrivialListener final : public Algorithm::Events::Subscriber<Event> {
+
+	  public:
+
+		void on(Event *event) final { keep(event->value); }
+	};
+
+	//listens to an event carrying a solution, so that the snapshots taken for it are delivered
+	template <class Event>
+	class SolutionListener final : public Algorithm::Events::Subscriber<Event> {
+
+	  public:
+
+		void on(Event *event) final { keep(event->elapsedTime.count()); }
+	};
+
+	//Firing without subscribers, i.e. the cost paid by the searchers for events the application doesn't use,
+	//both straight and gated by Events::isHeard, and handing the events over to the asynchronous dispatcher.
+	//Firing to one and to many trivial subscribers gives the cost of the dispatch per listener, on top of which comes what the listeners do.
+	void events(Runner &runner)
+	{
+		int value{0};
+		runner.run("events/Fire no listeners", [&] {
+			Ctoolhu::Event::Fire(UnheardEvent{value++});
+		});
+		{
+			const TrivialListener<HeardEvent> listener;
+			runner.run("events/Fire 1 listener", [&] {
+				Ctoolhu::Event::Fire(HeardEvent{value++});
+			});
+		}
+		{
+			std::vector<std::unique_ptr<TrivialListener<HeardEvent>>> listeners;
+			for (int i = 0; i < 16; ++i)
+				listeners.push_back(std::make_unique<TrivialListener<HeardEvent>>());
+
+			runner.run("events/Fire 16 listeners", [&] {
+				Ctoolhu::Event::Fire(HeardEvent{value++});
+			});
+		}
+		runner.run("events/Fire no listeners, solution payload", [&] {
+			Ctoolhu::Event::Fire(Algorithm::Events::CurrentSolutionChanged{nullptr, std::chrono::milliseconds{value++}});
+		});
+		{
+			const TrivialListener<HeardEvent> listener;
+			runner.run("events/isHeard gated, 1 listener", [&] {
+				if (Algorithm::Events::isHeard<HeardEvent>())
+					Ctoolhu::Event::Fire(HeardEvent{value++});
+			});
+		}
+		runner.run("events/isHeard gated, no listeners", [&] {
+			if (Algorithm::Events::isHeard<UnheardEvent>())
+				Ctoolhu::Event::Fire(UnheardEvent{value++});
+		});
+		{
+			boost::property_tree::ptree pt;
+			pt.put("vertices", 250);
+			pt.put("density", 0.1);
+			pt.put("colors", 8);
+			pt.put("seed", 1);
+			GraphColoring::Solution solution{std::make_shared<const GraphColoring::Instance>(pt), 1};
+
+			//dropping rather than blocking, so that the time of the dispatcher thread isn't measured
+			const Algorithm::Events::AsyncDispatcher dispatcher{std::chrono::milliseconds{10}, 4096, Algorithm::Events::AsyncDispatcher::Overflow::drop};
+			const SolutionListener<Algorithm::Events::CurrentSolutionChanged> currentListener;
+			const SolutionListener<Algorithm::Events::BestSolutionFound> bestListener;
+			runner.run("events/publish async", [&] {
+				Algorithm::Events::publish<GraphColoring::Solution>(UnheardEvent{value++});
+			});
+			runner.run("events/publish async, current solution (coloring 250)", [&] {
+				Algorithm::Events::publish<GraphColoring::Solution>(Algorithm::Events::CurrentSolutionChanged{&solution, std::chrono::milliseconds{value++}});
+			});
+			runner.run("events/publish async, best solution (coloring 250)", [&] {
+				Algorithm::Events::publish<GraphColoring::Solution>(Algorithm::Events::BestSolutionFound{&solution, std::chrono::milliseconds{value++}});
+			});
+		}
+	}
+
+	//parent without a control token, which forces the slow path of the stop check
+	class OpaqueParent final : public Algorithm::IAlgorithm {
+
+	  public:
+
+		const std::string &name() const noexcept final { return _name; }
+		void pauseAsync() noexcept final {}
+		void resumeAsync() noexcept final {}
+		void stopAsync() noexcept final {}
+		bool isStopRequested() const noexcept final { return false; }
+		std::chrono::milliseconds elapsedTime() const noexcept final { return std::chrono::milliseconds{0}; }
+
+	  private:
+
+		static inline const std::string _name{"Opaque parent"};
+	};
+
+	void stopRequests(Runner &runner)
+	{
+		const boost::property_tree::ptree pt;
+		std::vector<std::unique_ptr<GraphColoring::RnaSearcher>> chain;
+		for (int i = 0; i < 4; ++i) {
+			chain.push_back(std::make_unique<GraphColoring::RnaSearcher>(pt));
+			if (i > 0)
+				chain[i]->setParent(chain[i - 1].get());
+		}
+		runner.run("isStopRequested/top level", [&] {
+			keep(chain.front()->isStopRequested());
+		});
+		runner.run("isStopRequested/nested 4 levels", [&] {
+			keep(chain.back()->isStopRequested());
+		});
+
+		OpaqueParent parent;
+		chain.front()->setParent(&parent);
+		runner.run("isStopRequested/nested 4 levels, parent without token", [&] {
+			keep(chain.back()->isStopRequested());
+		});
+	}
+
+} //ns Benchmark::Micro
+
+int main(int argc, char *argv[])
+{
+	const std::string filter{argc > 1 ? argv[1] : ""};
+	std::ofstream file;
+	if (argc > 2) {
+		file.open(argv[2]);
+		if (!file) {
+			std::cerr << "Cannot open " << argv[2] << std::endl;
+			return 1;
+		}
+	}
+
+	try {
+		using namespace Benchmark::Micro;
+		Runner runner{argc > 2 ? file : std::cout, filter};
+		tabuList<Algorithm::TabuSearch::TabuList>(runner, "TabuList");
+		tabuList<Algorithm::TabuSearch::HashedTabuList>(runner, "HashedTabuList");
+		cycleCheck(runner);
+		solutionCopy(runner);
+		random(runner);
+		fitness(runner);
+		factory(runner);
+		events(runner);
+		stopRequests(runner);
+	}
+	catch (const std::exception &e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
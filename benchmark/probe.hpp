@@ -0,0 +1,60 @@
+#ifndef _benchmark_probe_included_
+#define _benchmark_probe_included_
+
+#include "../localsearch/fitness.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Benchmark {
+
+	//Measurements of the running benchmark case, fed by the reference problems.
+	//Only one case runs at a time, but the searchers may report from several threads.
+	class Probe {
+
+	  public:
+
+		using clock_t = std::chrono::steady_clock;
+
+		static void start(Algorithm::Fitness target) noexcept
+		{
+			_steps = 0;
+			_target = target;
+			_reachedAt = 0;
+			_started = clock_t::now();
+		}
+
+		//one search step taken (tabu step executed or RNA walk attempted)
+		static void step() noexcept
+		{
+			_steps.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		//fitness of a solution changed
+		static void fitness(Algorithm::Fitness fitness) noexcept
+		{
+			if (fitness <= _target && _reachedAt.load(std::memory_order_relaxed) == 0) {
+				const std::int64_t elapsed{std::chrono::duration_cast<std::chrono::microseconds>(clock_t::now() - _started).count()};
+				std::int64_t unreached{0};
+				_reachedAt.compare_exchange_strong(unreached, elapsed + 1); //zero means not reached
+			}
+		}
+
+		static std::int64_t steps() noexcept { return _steps.load(); }
+
+		//microseconds from start until the target fitness was first reached, negative if it wasn't
+		static std::int64_t timeToTarget() noexcept { return _reachedAt.load() - 1; }
+
+		static clock_t::time_point started() noexcept { return _started; }
+
+	  private:
+
+		static inline std::atomic<std::int64_t> _steps{0};
+		static inline std::atomic<std::int64_t> _reachedAt{0};
+		static inline Algorithm::Fitness _target;
+		static inline clock_t::time_point _started;
+	};
+
+} //ns Benchmark
+
+#endif //file guard
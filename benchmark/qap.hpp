@@ -0,0 +1,479 @@
+#ifndef _benchmark_qap_included_
+#define _benchmark_qap_included_
+
+#include "probe.hpp"
+#include "runner.hpp"
+#include "../localsearch/algorithm/annealing_search.hpp"
+#include "../localsearch/algorithm/checkpoint.hpp"
+#include "../localsearch/algorithm/hashed_tabu_list.hpp"
+#include "../localsearch/algorithm/late_acceptance_search.hpp"
+#include "../localsearch/algorithm/move_batch.hpp"
+#include "../localsearch/algorithm/rna_search.hpp"
+#include "../localsearch/algorithm/tabu_search.hpp"
+#include "../localsearch/factory.hpp"
+#include "../localsearch/interface/isolution.h"
+#include "../localsearch/interface/istep.h"
+#include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <ostream>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+//Quadratic assignment problem: assign n facilities to n locations, minimizing the sum of flows multiplied by distances.
+namespace Benchmark::QAP {
+
+	//random symmetric flow and distance matrices with zero diagonals
+	struct Instance {
+
+		Instance(const boost::property_tree::ptree &pt)
+		:
+			size{pt.get<int>("size")},
+			flows(size * size, 0),
+			distances(size * size, 0)
+		{
+			std::mt19937 random{pt.get<unsigned>("seed")};
+			std::uniform_int_distribution<int> value{0, 99};
+			for (int i = 0; i < size; ++i) {
+				for (int j = i + 1; j < size; ++j) {
+					flows[i * size + j] = flows[j * size + i] = value(random);
+					distances[i * size + j] = distances[j * size + i] = value(random);
+				}
+			}
+		}
+
+		int flow(int i, int j) const noexcept { return flows[i * size + j]; }
+		int distance(int i, int j) const noexcept { return distances[i * size + j]; }
+
+		int size;
+		std::vector<int> flows; //between facilities (size x size)
+		std::vector<int> distances; //between locations (size x size)
+	};
+
+	//move descriptor for batch evaluation, swap of locations of facilities a < b
+	struct Swap {
+		int a;
+		int b;
+	};
+
+	class Solution final : public Algorithm::ISolution {
+
+	  public:
+
+		Solution(std::shared_ptr<const Instance> instance, unsigned seed)
+		:
+			_instance{std::move(instance)},
+			_location(_instance->size)
+		{
+			std::iota(_location.begin(), _location.end(), 0);
+			std::ranges::shuffle(_location, std::mt19937{seed});
+			markDirty();
+		}
+
+		Solution(const Solution &other)
+		:
+			_instance{other._instance},
+			_location{other._location},
+			_cost{other._cost}
+		{
+		}
+
+		Solution &operator=(const Solution &other)
+		{
+			_instance = other._instance;
+			_location = other._location;
+			_cost = other._cost;
+			return *this;
+		}
+
+		bool operator==(const Solution &other) const noexcept { return _location == other._location; }
+
+		//number of facilities placed differently, for the diversity of the elite pool
+		int distance(const Solution &other) const noexcept
+		{
+			int distance{0};
+			for (std::size_t i = 0; i < _location.size(); ++i)
+				distance += _location[i] != other._location[i];
+
+			return distance;
+		}
+
+		bool normalize() noexcept final { return false; }
+		Algorithm::Fitness getFitness() noexcept final { return Algorithm::Fitness{_cost}; }
+		bool isFeasible() noexcept final { return true; }
+
+		void markDirty() final
+		{
+			_cost = 0;
+			for (int i = 0; i < _instance->size; ++i) {
+				for (int j = i + 1; j < _instance->size; ++j)
+					_cost += _instance->flow(i, j) * _instance->distance(_location[i], _location[j]);
+			}
+		}
+
+		void load(const boost::property_tree::ptree &pt) final
+		{
+			std::istringstream in{pt.get<std::string>("locations")};
+			for (auto &location : _location)
+				in >> location;
+
+			markDirty();
+		}
+
+		void save(boost::property_tree::ptree &pt) final
+		{
+			std::as_const(*this).save(pt);
+		}
+
+		void save(boost::property_tree::ptree &pt) const final
+		{
+			std::ostringstream out;
+			for (int location : _location)
+				out << location << ' ';
+
+			pt.put("locations", out.str());
+		}
+
+		//binary form for checkpoints
+		void save(Algorithm::Checkpoint::Writer &out) const
+		{
+			out.write(_location);
+		}
+
+		void load(Algorithm::Checkpoint::Reader &in)
+		{
+			in.read(_location);
+			markDirty();
+		}
+
+		const Instance &instance() const noexcept { return *_instance; }
+		int location(int facility) const noexcept { return _location[facility]; }
+
+		//change of cost if the locations of the facilities were swapped, in O(n)
+		int delta(int a, int b) const noexcept
+		{
+			auto const &instance = *_instance;
+			const int la{_location[a]};
+			const int lb{_location[b]};
+			int delta{0};
+			for (int k = 0; k < instance.size; ++k) {
+				if (k != a && k != b)
+					delta += (instance.flow(a, k) - instance.flow(b, k)) * (instance.distance(lb, _location[k]) - instance.distance(la, _location[k]));
+			}
+			return delta;
+		}
+
+		//Batch evaluation of swaps.
+		//Sums over all facilities without branching, so that the inner loop can be vectorized, and corrects for the terms of a and b afterwards
+		//(these add up to -2 * flow(a, b) * distance(la, lb), given the symmetric matrices with zero diagonals).
+		void evaluate(std::span<const Swap> swaps, std::span<Algorithm::Fitness::delta_t> deltas, std::span<Algorithm::AdaptedFitness::delta_t> adaptedDeltas) const noexcept
+		{
+			auto const &instance = *_instance;
+			const int n{instance.size};
+			const int *location{_location.data()};
+			for (std::size_t i = 0; i < swaps.size(); ++i) {
+				auto const [a, b] = swaps[i];
+				const int la{location[a]};
+				const int lb{location[b]};
+				const int *flowA{&instance.flows[a * n]};
+				const int *flowB{&instance.flows[b * n]};
+				const int *distanceA{&instance.distances[la * n]};
+				const int *distanceB{&instance.distances[lb * n]};
+				int delta{0};
+				for (int k = 0; k < n; ++k)
+					delta += (flowA[k] - flowB[k]) * (distanceB[location[k]] - distanceA[location[k]]);
+
+				delta += 2 * flowA[b] * distanceA[lb];
+				deltas[i] = delta;
+				adaptedDeltas[i] = delta;
+			}
+		}
+
+		void swap(int a, int b) noexcept
+		{
+			_cost += delta(a, b);
+			std::swap(_location[a], _location[b]);
+			Probe::fitness(getFitness());
+		}
+
+	  private:
+
+		std::shared_ptr<const Instance> _instance;
+		std::vector<int> _location; //location of each facility
+		int _cost{0};
+	};
+
+	//swap of locations of two facilities, its own undo
+	class Step final : public Algorithm::IStep<Solution> {
+
+	  public:
+
+		Step(const Solution &solution, int a, int b) noexcept
+		:
+			_a{a},
+			_b{b},
+			_key{static_cast<std::size_t>(a * solution.instance().size + b)},
+			_delta{solution.delta(a, b)}
+		{
+		}
+
+		//with the delta from batch evaluation
+		Step(const Solution &solution, int a, int b, int delta) noexcept
+		:
+			_a{a},
+			_b{b},
+			_key{static_cast<std::size_t>(a * solution.instance().size + b)},
+			_delta{delta}
+		{
+		}
+
+		Algorithm::AdaptedFitness::delta_t adaptedDelta() const noexcept final { return _delta; }
+		Algorithm::Fitness::delta_t delta() const noexcept final { return _delta; }
+
+		void execute(Solution &solution) const final
+		{
+			Probe::step();
+			solution.swap(_a, _b);
+		}
+
+		void undo(Solution &solution) const
+		{
+			solution.swap(_a, _b);
+		}
+
+		void dump(std::ostream &out) const final
+		{
+			out << "swap " << _a << " <-> " << _b;
+		}
+
+		//hashed tabu list interface
+		std::size_t tabuKey() const noexcept { return _key; }
+		std::size_t undoKey() const noexcept { return _key; }
+
+	  private:
+
+		int _a;
+		int _b; //always greater than a
+		std::size_t _key;
+		int _delta;
+	};
+
+	//Swaps the pair of facilities with the best delta.
+	//Each partition holds the swaps of one facility with the facilities after it, which are evaluated as a batch.
+	class TabuSearcher final : public Algorithm::TabuSearch::Searcher<Solution, Step, Algorithm::TabuSearch::HashedTabuList> {
+
+	  public:
+
+		using Algorithm::TabuSearch::Searcher<Solution, Step, Algorithm::TabuSearch::HashedTabuList>::Searcher;
+
+		const std::string &name() const noexcept final { return _name; }
+
+	  private:
+
+		int _getPartitionCount(Solution &solution) const final
+		{
+			return solution.instance().size - 1;
+		}
+
+		void _evaluatePartition(Solution &solution, int a, Candidates &candidates) const final
+		{
+			thread_local Algorithm::TabuSearch::MoveBatch<Swap> batch; //partitions can be evaluated in parallel
+			batch.clear();
+			for (int b = a + 1; b < solution.instance().size; ++b)
+				batch.push_back(Swap{a, b});
+
+			batch.evaluate(solution);
+			candidates.offer(batch, [this, &solution](const Swap &swap, Algorithm::Fitness::delta_t delta, Algorithm::AdaptedFitness::delta_t) {
+				return makeStep(solution, swap.a, swap.b, static_cast<int>(delta));
+			});
+		}
+
+		static inline const std::string _name{"QAP tabu search"};
+	};
+
+	//swaps a random pair of facilities if it doesn't make things worse
+	class RnaSearcher final : public Algorithm::RNA::Searcher<Solution> {
+
+	  public:
+
+		using Algorithm::RNA::Searcher<Solution>::Searcher;
+
+		const std::string &name() const noexcept final { return _name; }
+
+	  private:
+
+		Algorithm::Fitness::delta_t _walk(Solution &solution) const final
+		{
+			Probe::step();
+			const int size{solution.instance().size};
+			const int a{_random().between(0, size - 2)};
+			const int b{_random().between(a + 1, size - 1)};
+			const int delta{solution.delta(a, b)};
+			if (delta > 0)
+				return 0;
+
+			solution.swap(a, b);
+			return delta;
+		}
+
+		static inline const std::string _name{"QAP RNA search"};
+	};
+
+	//swaps the facilities of two random locations if the annealing accepts it
+	class AnnealingSearcher final : public Algorithm::Annealing::Searcher<Solution> {
+
+	  public:
+
+		using Algorithm::Annealing::Searcher<Solution>::Searcher;
+
+		const std::string &name() const noexcept final { return _name; }
+
+	  private:
+
+		Algorithm::Fitness::delta_t _walk(Solution &solution, Algorithm::Fitness::delta_t maxDelta) const final
+		{
+			Probe::step();
+			const auto size = static_cast<std::uint32_t>(solution.instance().size);
+			const int a{static_cast<int>(_random().below(size))};
+			const int b{static_cast<int>((a + 1 + _random().below(size - 1)) % size)};
+			const int delta{solution.delta(a, b)};
+			if (delta > maxDelta)
+				return 0;
+
+			solution.swap(a, b);
+			return delta;
+		}
+
+		static inline const std::string _name{"QAP annealing search"};
+	};
+
+	//swaps the facilities of two random locations if the late acceptance allows it
+	class LateAcceptanceSearcher final : public Algorithm::LateAcceptance::Searcher<Solution> {
+
+	  public:
+
+		using Algorithm::LateAcceptance::Searcher<Solution>::Searcher;
+
+		const std::string &name() const noexcept final { return _name; }
+
+	  private:
+
+		Algorithm::Fitness::delta_t _walk(Solution &solution, Algorithm::Fitness::delta_t maxDelta) const final
+		{
+			Probe::step();
+			const auto size = static_cast<std::uint32_t>(solution.instance().size);
+			const int a{static_cast<int>(_random().below(size))};
+			const int b{static_cast<int>((a + 1 + _random().below(size - 1)) % size)};
+			const int delta{solution.delta(a, b)};
+			if (delta > maxDelta)
+				return 0;
+
+			solution.swap(a, b);
+			return delta;
+		}
+
+		static inline const std::string _name{"QAP late acceptance search"};
+	};
+
+	inline void run(Runner &runner)
+	{
+		[[maybe_unused]] static const bool registered = [] {
+			auto &factory = Algorithm::SingleFactory<Solution>::Instance();
+			factory.registerAlgorithm("tabu", [](const boost::property_tree::ptree &pt) { return std::make_unique<TabuSearcher>(pt); });
+			factory.registerAlgorithm("rna", [](const boost::property_tree::ptree &pt) { return std::make_unique<RnaSearcher>(pt); });
+			factory.registerAlgorithm("annealing", [](const boost::property_tree::ptree &pt) { return std::make_unique<AnnealingSearcher>(pt); });
+			factory.registerAlgorithm("lahc", [](const boost::property_tree::ptree &pt) { return std::make_unique<LateAcceptanceSearcher>(pt); });
+			return true;
+		}();
+
+		auto const createSolution = [](const boost::property_tree::ptree &pt) {
+			return std::make_unique<Solution>(std::make_shared<const Instance>(pt), pt.get<unsigned>("seed"));
+		};
+
+		runner.run<Solution>("qap", R"({
+			"name": "tabu",
+			"instance": {"size": 25, "seed": 1},
+			"target": 540000,
+			"search": {
+				"benchmark": true, "repeat": 1, "cycles": 2,
+				"algorithms": [
+					{"name": "tabu", "config": {"maxSteps": 2000, "tabuLower": 10, "tabuUpper": 20}}
+				]
+			}
+		})", createSolution);
+
+		runner.run<Solution>("qap", R"({
+			"name": "rna+tabu-repeats",
+			"instance": {"size": 25, "seed": 1},
+			"target": 540000,
+			"search": {
+				"benchmark": true, "repeat": 4, "threads": 4, "cycles": 2,
+				"algorithms": [
+					{"name": "rna", "config": {"maxSteps": 5000}},
+					{"name": "tabu", "config": {"maxSteps": 2000, "tabuLower": 10, "tabuUpper": 20}}
+				]
+			}
+		})", createSolution);
+
+		//restarts of the tabu search from the initial solution, and from the pool of the best results of the previous restarts
+		runner.run<Solution>("qap", R"({
+			"name": "tabu-restarts",
+			"instance": {"size": 30, "seed": 1},
+			"target": 828000,
+			"search": {
+				"benchmark": true, "repeat": 16, "cycles": 1,
+				"algorithms": [
+					{"name": "tabu", "config": {"maxSteps": 200, "tabuLower": 10, "tabuUpper": 20}}
+				]
+			}
+		})", createSolution);
+
+		runner.run<Solution>("qap", R"({
+			"name": "tabu-restarts-elite",
+			"instance": {"size": 30, "seed": 1},
+			"target": 828000,
+			"search": {
+				"benchmark": true, "repeat": 16, "cycles": 1, "elitePool": 4, "eliteDistance": 5,
+				"algorithms": [
+					{"name": "tabu", "config": {"maxSteps": 200, "tabuLower": 10, "tabuUpper": 20}}
+				]
+			}
+		})", createSolution);
+
+		runner.run<Solution>("qap", R"({
+			"name": "annealing+tabu",
+			"instance": {"size": 25, "seed": 1},
+			"target": 540000,
+			"search": {
+				"benchmark": true, "repeat": 1, "cycles": 2,
+				"algorithms": [
+					{"name": "annealing", "config": {"maxSteps": 200000, "initialTemperature": 20000, "finalTemperature": 50}},
+					{"name": "tabu", "config": {"maxSteps": 2000, "tabuLower": 10, "tabuUpper": 20}}
+				]
+			}
+		})", createSolution);
+
+		runner.run<Solution>("qap", R"({
+			"name": "lahc+tabu",
+			"instance": {"size": 25, "seed": 1},
+			"target": 540000,
+			"search": {
+				"benchmark": true, "repeat": 1, "cycles": 2,
+				"algorithms": [
+					{"name": "lahc", "config": {"historyLength": 2000}},
+					{"name": "tabu", "config": {"maxSteps": 2000, "tabuLower": 10, "tabuUpper": 20}}
+				]
+			}
+		})", createSolution);
+	}
+
+} //ns Benchmark::QAP
+
+#endif //file guard
@@ -0,0 +1,101 @@
+#ifndef _benchmark_runner_included_
+#define _benchmark_runner_included_
+
+#include "memory.hpp"
+#include "probe.hpp"
+#include "../localsearch/algorithm/chained_search.hpp"
+#include "../localsearch/fitness.hpp"
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+namespace Benchmark {
+
+	//chained search over the searchers of a reference problem
+	template <class Solution>
+	class ChainedSearcher final : public Algorithm::ChainedSearch::Searcher<Solution> {
+
+	  public:
+
+		using Algorithm::ChainedSearch::Searcher<Solution>::Searcher;
+
+		const std::string &name() const noexcept final { return _name; }
+
+	  private:
+
+		static inline const std::string _name{"Chained search"};
+	};
+
+	//Runs benchmark cases and writes one line of JSON per case.
+	//A case is a JSON definition with the following nodes:
+	//	name - identifies the case within its problem
+	//	instance - passed to the problem to generate the instance and the initial solution (including the seed)
+	//	target - fitness for the time-to-target measurement
+	//	search - configuration of the chained search run on the initial solution
+	class Runner {
+
+	  public:
+
+		Runner(std::ostream &out, std::string filter)
+		:
+			_out{out},
+			_filter{std::move(filter)}
+		{
+		}
+
+		template <class Solution>
+		void run(const std::string &problem, const std::string &definition, const std::function<std::unique_ptr<Solution>(const boost::property_tree::ptree &)> &createSolution)
+		{
+			boost::property_tree::ptree pt;
+			std::istringstream in{definition};
+			boost::property_tree::read_json(in, pt);
+
+			const std::string id{problem + "/" + pt.get<std::string>("name")};
+			if (id.find(_filter) == std::string::npos)
+				return;
+
+			auto const &instance = pt.get_child("instance");
+			auto solutionPtr = createSolution(instance);
+			const Algorithm::Fitness initial{solutionPtr->getFitness()};
+			const Algorithm::Fitness target{pt.get<int>("target")};
+			ChainedSearcher<Solution> searcher{pt.get_child("search")};
+
+			Probe::start(target);
+			Probe::fitness(initial);
+			searcher.start(*solutionPtr);
+			const std::chrono::duration<double> elapsed{Probe::clock_t::now() - Probe::started()};
+
+			const auto steps = Probe::steps();
+			const auto timeToTarget = Probe::timeToTarget();
+			_out
+				<< "{\"case\": \"" << id << "\""
+				<< ", \"seed\": " << instance.get("seed", 0)
+				<< ", \"initialFitness\": " << initial
+				<< ", \"finalFitness\": " << solutionPtr->getFitness()
+				<< ", \"target\": " << target
+				<< ", \"steps\": " << steps
+				<< ", \"seconds\": " << elapsed.count()
+				<< ", \"stepsPerSecond\": " << (elapsed.count() > 0 ? steps / elapsed.count() : 0.0)
+				<< ", \"timeToTargetMs\": ";
+			if (timeToTarget < 0)
+				_out << "null";
+			else
+				_out << timeToTarget / 1000.0;
+
+			_out << ", \"peakMemoryKB\": " << peakMemoryKB() << "}" << std::endl;
+		}
+
+	  private:
+
+		std::ostream &_out;
+		std::string _filter; //only cases with the filter in their "problem/name" identifier are run
+	};
+
+} //ns Benchmark
+
+#endif //file guard
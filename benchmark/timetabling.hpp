@@ -0,0 +1,368 @@
+#ifndef _benchmark_timetabling_included_
+#define _benchmark_timetabling_included_
+
+#include "probe.hpp"
+#include "runner.hpp"
+#include "../localsearch/algorithm/rna_search.hpp"
+#include "../localsearch/algorithm/tabu_search.hpp"
+#include "../localsearch/factory.hpp"
+#include "../localsearch/interface/isolution.h"
+#include "../localsearch/interface/istep.h"
+#include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+//Small timetabling model: place events into timeslots of a week.
+//Hard constraints: events sharing students can't take place at the same time, and there's a limited number of rooms.
+//Soft constraint: events should avoid the last timeslot of a day.
+namespace Benchmark::Timetabling {
+
+	//random enrollment of students into events
+	struct Instance {
+
+		Instance(const boost::property_tree::ptree &pt)
+		:
+			events{pt.get<int>("events")},
+			days{pt.get<int>("days")},
+			slotsPerDay{pt.get<int>("slotsPerDay")},
+			rooms{pt.get<int>("rooms")},
+			conflicting(events)
+		{
+			std::mt19937 random{pt.get<unsigned>("seed")};
+			std::uniform_int_distribution<int> event{0, events - 1};
+			const int students{pt.get<int>("students")};
+			const int eventsPerStudent{pt.get<int>("eventsPerStudent")};
+			std::vector<std::vector<bool>> shared(events, std::vector<bool>(events, false));
+			for (int s = 0; s < students; ++s) {
+				std::vector<int> enrolled;
+				while (static_cast<int>(enrolled.size()) < eventsPerStudent) {
+					const int e{event(random)};
+					if (std::ranges::find(enrolled, e) == enrolled.end())
+						enrolled.push_back(e);
+				}
+				for (int a : enrolled) {
+					for (int b : enrolled) {
+						if (a != b && !shared[a][b]) {
+							shared[a][b] = true;
+							conflicting[a].push_back(b);
+						}
+					}
+				}
+			}
+		}
+
+		int slots() const noexcept { return days * slotsPerDay; }
+		bool isLastOfDay(int slot) const noexcept { return slot % slotsPerDay == slotsPerDay - 1; }
+
+		int events;
+		int days;
+		int slotsPerDay;
+		int rooms;
+		std::vector<std::vector<int>> conflicting; //events sharing a student with each event
+	};
+
+	class Solution final : public Algorithm::ISolution {
+
+	  public:
+
+		static constexpr int hardWeight{100};
+
+		Solution(std::shared_ptr<const Instance> instance, unsigned seed)
+		:
+			_instance{std::move(instance)},
+			_slot(_instance->events),
+			_clashes(_instance->events * _instance->slots(), 0),
+			_load(_instance->slots(), 0)
+		{
+			std::mt19937 random{seed};
+			std::uniform_int_distribution<int> slot{0, _instance->slots() - 1};
+			for (auto &s : _slot)
+				s = slot(random);
+
+			markDirty();
+		}
+
+		Solution(const Solution &other)
+		:
+			_instance{other._instance},
+			_slot{other._slot},
+			_clashes{other._clashes},
+			_load{other._load},
+			_hard{other._hard},
+			_soft{other._soft}
+		{
+		}
+
+		Solution &operator=(const Solution &other)
+		{
+			_instance = other._instance;
+			_slot = other._slot;
+			_clashes = other._clashes;
+			_load = other._load;
+			_hard = other._hard;
+			_soft = other._soft;
+			return *this;
+		}
+
+		bool operator==(const Solution &other) const noexcept { return _slot == other._slot; }
+
+		bool normalize() noexcept final { return false; }
+		Algorithm::Fitness getFitness() noexcept final { return Algorithm::Fitness{_hard * hardWeight + _soft}; }
+		bool isFeasible() noexcept final { return _hard == 0; }
+
+		void markDirty() final
+		{
+			auto const &instance = *_instance;
+			std::ranges::fill(_clashes, 0);
+			std::ranges::fill(_load, 0);
+			_hard = 0;
+			_soft = 0;
+			for (int e = 0; e < instance.events; ++e) {
+				for (int other : instance.conflicting[e]) {
+					_clashes[e * instance.slots() + _slot[other]]++;
+					if (e < other && _slot[e] == _slot[other])
+						_hard++;
+				}
+				_load[_slot[e]]++;
+				if (instance.isLastOfDay(_slot[e]))
+					_soft++;
+			}
+			for (int load : _load)
+				_hard += _overflow(load);
+		}
+
+		void load(const boost::property_tree::ptree &pt) final
+		{
+			std::istringstream in{pt.get<std::string>("slots")};
+			for (auto &slot : _slot)
+				in >> slot;
+
+			markDirty();
+		}
+
+		void save(boost::property_tree::ptree &pt) final
+		{
+			std::as_const(*this).save(pt);
+		}
+
+		void save(boost::property_tree::ptree &pt) const final
+		{
+			std::ostringstream out;
+			for (int slot : _slot)
+				out << slot << ' ';
+
+			pt.put("slots", out.str());
+		}
+
+		const Instance &instance() const noexcept { return *_instance; }
+		int slot(int event) const noexcept { return _slot[event]; }
+		int eventsIn(int slot) const noexcept { return _load[slot]; }
+
+		//number of events clashing with the event if it took place in the slot
+		int clashes(int event, int slot) const noexcept { return _clashes[event * _instance->slots() + slot]; }
+
+		//change of fitness if the event was moved to the slot
+		int delta(int event, int slot) const noexcept
+		{
+			const int from{_slot[event]};
+			if (slot == from)
+				return 0;
+
+			const int hard{
+				clashes(event, slot) - clashes(event, from)
+				+ _overflow(_load[from] - 1) - _overflow(_load[from])
+				+ _overflow(_load[slot] + 1) - _overflow(_load[slot])
+			};
+			const int soft{_instance->isLastOfDay(slot) - _instance->isLastOfDay(from)};
+			return hard * hardWeight + soft;
+		}
+
+		void move(int event, int slot) noexcept
+		{
+			auto const &instance = *_instance;
+			const int from{_slot[event]};
+			if (slot == from)
+				return;
+
+			_hard += clashes(event, slot) - clashes(event, from);
+			_hard += _overflow(_load[from] - 1) - _overflow(_load[from]) + _overflow(_load[slot] + 1) - _overflow(_load[slot]);
+			_soft += instance.isLastOfDay(slot) - instance.isLastOfDay(from);
+			for (int other : instance.conflicting[event]) {
+				_clashes[other * instance.slots() + from]--;
+				_clashes[other * instance.slots() + slot]++;
+			}
+			_load[from]--;
+			_load[slot]++;
+			_slot[event] = slot;
+			Probe::fitness(getFitness());
+		}
+
+	  private:
+
+		int _overflow(int load) const noexcept { return std::max(0, load - _instance->rooms); }
+
+		std::shared_ptr<const Instance> _instance;
+		std::vector<int> _slot; //timeslot of each event
+		std::vector<int> _clashes; //number of conflicting events of each event in each slot (events x slots)
+		std::vector<int> _load; //number of events in each slot
+		int _hard{0};
+		int _soft{0};
+	};
+
+	class Step final : public Algorithm::IStep<Solution> {
+
+	  public:
+
+		Step(const Solution &solution, int event, int slot) noexcept
+		:
+			_event{event},
+			_from{solution.slot(event)},
+			_to{slot},
+			_delta{solution.delta(event, slot)}
+		{
+		}
+
+		Algorithm::AdaptedFitness::delta_t adaptedDelta() const noexcept final { return _delta; }
+		Algorithm::Fitness::delta_t delta() const noexcept final { return _delta; }
+
+		void execute(Solution &solution) const final
+		{
+			Probe::step();
+			solution.move(_event, _to);
+		}
+
+		void undo(Solution &solution) const
+		{
+			solution.move(_event, _from);
+		}
+
+		void dump(std::ostream &out) const final
+		{
+			out << "event " << _event << ": " << _from << " -> " << _to;
+		}
+
+		//tabu list interface
+		bool isUndoOf(const Step &other) const noexcept { return _event == other._event && _to == other._from; }
+		bool isEqualForShortTermTabu(const Step &other) const noexcept { return _event == other._event; }
+
+	  private:
+
+		int _event;
+		int _from;
+		int _to;
+		int _delta;
+	};
+
+	//Moves an event to the best slot.
+	//Only events violating hard constraints are moved, unless the timetable is feasible.
+	class TabuSearcher final : public Algorithm::TabuSearch::Searcher<Solution, Step> {
+
+	  public:
+
+		using Algorithm::TabuSearch::Searcher<Solution, Step>::Searcher;
+
+		const std::string &name() const noexcept final { return _name; }
+
+	  private:
+
+		int _getPartitionCount(Solution &solution) const final
+		{
+			return solution.instance().days;
+		}
+
+		//events currently placed in the day of the partition
+		void _evaluatePartition(Solution &solution, int day, Candidates &candidates) const final
+		{
+			auto const &instance = solution.instance();
+			const bool feasible{solution.isFeasible()};
+			for (int event = 0; event < instance.events; ++event) {
+				const int from{solution.slot(event)};
+				if (from / instance.slotsPerDay != day || (!feasible && solution.clashes(event, from) == 0 && solution.eventsIn(from) <= instance.rooms))
+					continue;
+
+				for (int slot = 0; slot < instance.slots(); ++slot) {
+					if (slot != from && candidates.isCompetitive(solution.delta(event, slot)))
+						candidates.offer(makeStep(solution, event, slot));
+				}
+			}
+		}
+
+		static inline const std::string _name{"Timetabling tabu search"};
+	};
+
+	//moves a random event to a random slot if it doesn't make things worse
+	class RnaSearcher final : public Algorithm::RNA::Searcher<Solution> {
+
+	  public:
+
+		using Algorithm::RNA::Searcher<Solution>::Searcher;
+
+		const std::string &name() const noexcept final { return _name; }
+
+	  private:
+
+		Algorithm::Fitness::delta_t _walk(Solution &solution) const final
+		{
+			Probe::step();
+			auto const &instance = solution.instance();
+			const int event{static_cast<int>(_random().below(instance.events))};
+			const int slot{static_cast<int>(_random().below(instance.slots()))};
+			const int delta{solution.delta(event, slot)};
+			if (delta > 0)
+				return 0;
+
+			solution.move(event, slot);
+			return delta;
+		}
+
+		static inline const std::string _name{"Timetabling RNA search"};
+	};
+
+	inline void run(Runner &runner)
+	{
+		[[maybe_unused]] static const bool registered = [] {
+			auto &factory = Algorithm::SingleFactory<Solution>::Instance();
+			factory.registerAlgorithm("tabu", [](const boost::property_tree::ptree &pt) { return std::make_unique<TabuSearcher>(pt); });
+			factory.registerAlgorithm("rna", [](const boost::property_tree::ptree &pt) { return std::make_unique<RnaSearcher>(pt); });
+			return true;
+		}();
+
+		auto const createSolution = [](const boost::property_tree::ptree &pt) {
+			return std::make_unique<Solution>(std::make_shared<const Instance>(pt), pt.get<unsigned>("seed"));
+		};
+
+		runner.run<Solution>("timetabling", R"({
+			"name": "rna+tabu",
+			"instance": {"events": 400, "days": 5, "slotsPerDay": 6, "rooms": 14, "students": 600, "eventsPerStudent": 6, "seed": 1},
+			"target": 99,
+			"search": {
+				"benchmark": true, "repeat": 1, "cycles": 4,
+				"algorithms": [
+					{"name": "rna", "config": {"maxSteps": 20000}},
+					{"name": "tabu", "config": {"maxSteps": 1000}}
+				]
+			}
+		})", createSolution);
+
+		runner.run<Solution>("timetabling", R"({
+			"name": "tabu-journal",
+			"instance": {"events": 400, "days": 5, "slotsPerDay": 6, "rooms": 14, "students": 600, "eventsPerStudent": 6, "seed": 1},
+			"target": 99,
+			"search": {
+				"benchmark": true, "repeat": 1, "cycles": 4,
+				"algorithms": [
+					{"name": "tabu", "config": {"maxSteps": 1000, "journal": true}}
+				]
+			}
+		})", createSolution);
+	}
+
+} //ns Benchmark::Timetabling
+
+#endif //file guard
@@ -0,0 +1,49 @@
+#ifndef _algorithm_algorithm_group_included_
+#define _algorithm_algorithm_group_included_
+
+#include "control_token.hpp"
+#include "../interface/ialgorithm.h"
+#include <chrono>
+#include <string>
+
+namespace Algorithm::Private {
+
+	//Parent for a group of algorithms run in parallel by another algorithm (the owner).
+	//Makes it possible to stop the whole group without stopping the owner, while stop and pause requests of the owner still reach the group.
+	class AlgorithmGroup : public IAlgorithm {
+
+	  public:
+
+		explicit AlgorithmGroup(IAlgorithm &owner) noexcept : _owner{owner}
+		{
+			_token.setParent(owner.controlToken(), true);
+		}
+
+		const std::string &name() const final { return _owner.name(); }
+
+		void pauseAsync() final { _owner.pauseAsync(); }
+		void resumeAsync() final { _owner.resumeAsync(); }
+
+		void stopAsync() noexcept final
+		{
+			_token.set(ControlToken::stopped, true);
+		}
+
+		bool isStopRequested() const final
+		{
+			return _token.has(ControlToken::stopped) || _owner.isStopRequested();
+		}
+
+		std::chrono::milliseconds elapsedTime() const final { return _owner.elapsedTime(); }
+
+		const ControlToken *controlToken() const noexcept final { return &_token; }
+
+	  private:
+
+		IAlgorithm &_owner;
+		ControlToken _token;
+	};
+
+} //ns Algorithm::Private
+
+#endif //file guard
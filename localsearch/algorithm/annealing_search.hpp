@@ -0,0 +1,187 @@
+#ifndef _algorithm_annealing_search_included_
+#define _algorithm_annealing_search_included_
+
+#include "base.hpp"
+#include "best_tracker.hpp"
+#include "checkpoint.hpp"
+#include "config.hpp"
+#include "profiler.hpp"
+#include "random.hpp"
+#include "../events/async_dispatcher.hpp"
+#include "../fitness.hpp"
+#include "../events/annealing_search_events.h"
+#include "../events/audience.h"
+#include "../interface/icheckpointed.h"
+#include "../interface/iprofiled.h"
+#include "../interface/isolution.h"
+#include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace Algorithm::Annealing {
+
+	//Simulated annealing, statically dispatched.
+	//Walks like the RNA search, but also accepts worsening steps, the less likely the worse they are and the colder it gets.
+	//The temperature cools geometrically from the initial to the final one over maxSteps steps (both in units of fitness).
+	//The derived class provides the search hooks, which are called directly, so that they can be inlined:
+	//	Fitness::delta_t _walk(Solution &, Fitness::delta_t maxDelta) const - proposes a random step,
+	//		executes it only if its delta doesn't exceed maxDelta and returns the delta of the executed step (zero if none)
+	//	bool _init(Solution &) - optional, prepares for walking and returns false if the algorithm can't run
+	//The hooks must be accessible to this class (public, or befriend it).
+	//The walk can draw its random numbers from _random(), which is cheaper than the shared engines.
+	template <class Derived, SearchSolution Solution>
+	class StaticSearcher : public AlgorithmBase<Solution>, public IProfiled, public ICheckpointed {
+
+	  public:
+
+		explicit StaticSearcher(const boost::property_tree::ptree &pt)
+		{
+			_config.load(pt);
+			_config.maxSteps = std::max(1, pt.get("maxSteps", 100000));
+			_config.initialTemperature = pt.get("initialTemperature", 10.0);
+			_config.finalTemperature = pt.get("finalTemperature", 0.1);
+			_config.tickFrequency = std::max(1, pt.get("tickFrequency", 1000));
+			_randomEngine.seed(_config.seed);
+			_profiler.enable(_config.profile);
+
+			if (!(_config.finalTemperature > 0 && _config.finalTemperature <= _config.initialTemperature))
+				throw std::runtime_error("Algorithm::Annealing::StaticSearcher: temperatures must be positive and the final one must not exceed the initial one");
+		}
+
+		struct Config : Algorithm::Config {
+			int maxSteps; //length of the cooling schedule
+			double initialTemperature;
+			double finalTemperature;
+			int tickFrequency; //how many steps between ticks
+		};
+
+		void enableExtensions() noexcept final { _config.extended = true; }
+		void disableExtensions() noexcept final { _config.extended = false; }
+		const Config &getConfig() const noexcept { return _config; }
+		Stats getStats() const noexcept final { return _profiler.stats(); }
+
+		//each run starts the cooling schedule again, only the random stream carries over
+		void saveState(Checkpoint::Writer &out) const final { out.write(_randomEngine.state()); }
+		void loadState(Checkpoint::Reader &in) final { _randomEngine.setState(in.read<std::array<std::uint64_t, 4>>()); }
+
+	  protected:
+
+		//default hook
+		bool _init(Solution &) { return true; }
+
+		Private::FastRandom &_random() const noexcept { return _randomEngine; }
+
+	  private:
+
+		bool _run(Solution &solution) noexcept(false) final
+		{
+			const Fitness startingFitness{solution.getFitness()};
+			Fitness bestFeasible{solution.isFeasible() ? startingFitness : Fitness::worst()}; //holds the fitness of the best feasible solution found so far
+			if (!_derived()._init(solution))
+				return false;
+
+			_best.reset(solution);
+			const int maxSteps{_config.maxSteps * (_config.extended ? 2 : 1)};
+			const double cooling{std::pow(_config.finalTemperature / _config.initialTemperature, 1.0 / maxSteps)};
+			double temperature{_config.initialTemperature};
+			for (int step = 1; step <= maxSteps && !this->isStopRequested() && !solution.getFitness().isZero(); ++step, temperature *= cooling) {
+				const Fitness original{solution.getFitness()};
+				const Fitness::delta_t maxDelta{_threshold(temperature)};
+				Fitness::delta_t delta;
+				{
+					const Private::Profiler::Scope _{_profiler, Phase::neighborhood};
+					delta = _derived()._walk(solution, maxDelta);
+				}
+				const Fitness actual{Private::checkWalkFitness(solution, original, delta, _profiler, "Algorithm::Annealing::StaticSearcher")};
+
+				if (delta > maxDelta)
+					throw std::logic_error("Algorithm::Annealing::StaticSearcher::run: search step exceeds the acceptance threshold");
+
+				if (delta != 0 && Algorithm::Events::isHeard<Algorithm::Events::CurrentSolutionChanged>()) {
+					const Private::Profiler::Scope _{_profiler, Phase::events};
+					Algorithm::Events::publish<Solution>(Algorithm::Events::CurrentSolutionChanged { &solution, this->elapsedTime() });
+				}
+				if (actual < _best.fitness() && _best.isReplaceableBy(solution, _config.keepFeasible)) {
+					_best.update(solution);
+					const Private::Profiler::Scope _{_profiler, Phase::events};
+					Algorithm::Events::publish<Solution>(Algorithm::Events::BestSolutionFound { &solution, this->elapsedTime() });
+				}
+				if (solution.isFeasible() && actual < bestFeasible) {
+					bestFeasible = actual;
+					const Private::Profiler::Scope _{_profiler, Phase::events};
+					Algorithm::Events::publish<Solution>(Algorithm::Events::FeasibleSolutionFound { &solution, this->elapsedTime() });
+				}
+				if (step % _config.tickFrequency == 0) {
+					const Private::Profiler::Scope _{_profiler, Phase::events};
+					Algorithm::Events::publish<Solution>(Events::Tick { temperature });
+				}
+			}
+
+			//end with the best solution found, preferring the current one if equal
+			if (solution.getFitness() > _best.fitness() || !_best.isReplaceableBy(solution, _config.keepFeasible)) {
+				_best.restore(solution);
+				Algorithm::Events::publish<Solution>(Algorithm::Events::CurrentSolutionChanged { &solution, this->elapsedTime() });
+			}
+			return solution.getFitness() < startingFitness;
+		}
+
+		//Highest delta accepted in this step.
+		//Accepting a step with probability exp(-delta / T) is the same as accepting it if delta <= -T * ln(u) for uniform u,
+		//so a single random number and a table lookup decide the acceptance before the walk, instead of an exp() per proposal.
+		Fitness::delta_t _threshold(double temperature) const noexcept
+		{
+			const double threshold{temperature * _thresholds[_randomEngine() >> (64 - _thresholdBits)]};
+			if (threshold >= static_cast<double>(Fitness::worstDelta()))
+				return Fitness::worstDelta();
+
+			return static_cast<Fitness::delta_t>(threshold); //truncation keeps the probability of integer deltas as close as the table allows
+		}
+
+		Derived &_derived() noexcept { return static_cast<Derived &>(*this); }
+
+		static constexpr int _thresholdBits{12};
+
+		//-ln(u) for u at the midpoints of a uniform grid over (0, 1)
+		static inline const std::array<double, std::size_t{1} << _thresholdBits> _thresholds = [] {
+			std::array<double, std::size_t{1} << _thresholdBits> thresholds;
+			for (std::size_t i = 0; i < thresholds.size(); ++i)
+				thresholds[i] = -std::log((static_cast<double>(i) + 0.5) / static_cast<double>(thresholds.size()));
+
+			return thresholds;
+		}();
+
+		Config _config;
+		mutable Private::FastRandom _randomEngine;
+		Private::Profiler _profiler;
+		Private::BestTracker<Solution> _best{_profiler};
+	};
+
+	//Simulated annealing
+	//Dynamically dispatched, derive from it and override the hooks.
+	template <class Solution>
+	class Searcher : public StaticSearcher<Searcher<Solution>, Solution> {
+
+		friend StaticSearcher<Searcher<Solution>, Solution>;
+
+	  public:
+
+		using StaticSearcher<Searcher<Solution>, Solution>::StaticSearcher;
+
+	  private:
+
+		//Prepare for walking, if necessary.
+		//Return false if algorithm cannot run.
+		virtual bool _init(Solution &) { return true; }
+
+		//Propose a random step and execute it if its delta doesn't exceed maxDelta.
+		//Return the delta of the executed step, zero if none.
+		virtual Fitness::delta_t _walk(Solution &, Fitness::delta_t maxDelta) const = 0;
+	};
+
+} //ns Algorithm::Annealing
+
+#endif //file guard
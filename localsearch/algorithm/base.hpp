@@ -4,7 +4,9 @@
 #ifndef _algorithm_base_included_
 #define _algorithm_base_included_
 
+#include "control_token.hpp"
 #include "../fitness.hpp"
+#include "../events/async_dispatcher.hpp"
 #include "../events/events.h"
 #include "../interface/ialgorithm_exec.h"
 #include "../interface/isolution.h"
@@ -29,46 +31,64 @@ namespace Algorithm {
 
 		bool start(Solution &solution) final
 		{
-			_stopRequested = false;
+			_setState(Private::ControlToken::stopped, false);
 			_timer.StartClock();
-			Ctoolhu::Event::Fire(Events::Started { &solution, this->name() });
+			const bool announced{!Events::Silenced::isActive()}; //not from the workers of a parallel search
+			if (announced)
+				Ctoolhu::Event::Fire(Events::Started { &solution, this->name() });
+
 			_normalize(solution);
 			const bool result{_run(solution)};
-			Ctoolhu::Event::Fire(Events::Finished { &solution, this->name(), this });
+			if (announced)
+				Ctoolhu::Event::Fire(Events::Finished { &solution, this->name(), this });
+
 			return result;
 		}
 
 		void pauseAsync() final
 		{
-			_togglePause(true);
+			_setState(Private::ControlToken::paused, true);
 		}
 
 		void resumeAsync() final
 		{
-			_togglePause(false);
+			_setState(Private::ControlToken::paused, false);
 		}
 
 		void stopAsync() final
 		{
-			std::lock_guard _{_pauseMutex};
-			_stopRequested = true;
+			_setState(Private::ControlToken::stopped, true);
 		}
 
 		bool isStopRequested() const final
 		{
+			//fast path for the common case, when nothing in the chain of algorithms is stopped or paused
+			if (_token.isClear())
+				return false;
+
 			std::unique_lock lock(_pauseMutex);
 
 			//if paused, don't allow continuation until resumed
-			while (_paused && !_stopRequested)
+			while (_token.has(Private::ControlToken::paused) && !_token.has(Private::ControlToken::stopped))
 				_pauseChanged.wait(lock);
 
-			return _stopRequested || (_parent && _parent->isStopRequested());
+			if (_token.has(Private::ControlToken::stopped))
+				return true;
+
+			lock.unlock();
+			return _parent && _parent->isStopRequested();
 		}
 
-		//for nested algorithms
+		//for nested algorithms, the stop and pause state of the parent is inherited through its control token
 		void setParent(IAlgorithm *parent) noexcept final
 		{
 			_parent = parent;
+			_token.setParent(parent ? parent->controlToken() : nullptr, parent != nullptr);
+		}
+
+		const Private::ControlToken *controlToken() const noexcept final
+		{
+			return &_token;
 		}
 
 		timer_resolution elapsedTime() const noexcept final
@@ -85,10 +105,10 @@ namespace Algorithm {
 		//algorithm body, should return true if solution was improved.
 		virtual bool _run(Solution &) = 0;
 
-		void _togglePause(bool pause)
+		void _setState(Private::ControlToken::Flag flag, bool on)
 		{
 			std::unique_lock lock(_pauseMutex);
-			_paused = pause;
+			_token.set(flag, on);
 			lock.unlock(); //manual unlocking is done before notifying... (from C++ reference)
 			_pauseChanged.notify_all();
 		}
@@ -100,15 +120,14 @@ namespace Algorithm {
 			if (changed) {
 				//results of the normalization must always be treated as a better solution,
 				//no matter the actual fitness
-				Ctoolhu::Event::Fire(Events::BestSolutionFound { &solution, elapsedTime() });
+				Events::publish<Solution>(Events::BestSolutionFound { &solution, elapsedTime() });
 				if (solution.isFeasible())
-					Ctoolhu::Event::Fire(Events::FeasibleSolutionFound { &solution, elapsedTime() });
+					Events::publish<Solution>(Events::FeasibleSolutionFound { &solution, elapsedTime() });
 			}
 		}
 
-		//algorithm stopping and pausing mechanism
-		bool _stopRequested{false};
-		bool _paused{false};
+		//algorithm stopping and pausing mechanism, the mutex is only needed to wait while paused
+		Private::ControlToken _token;
 		mutable std::mutex _pauseMutex;
 		mutable std::condition_variable _pauseChanged;
 
@@ -0,0 +1,81 @@
+#ifndef _algorithm_best_tracker_included_
+#define _algorithm_best_tracker_included_
+
+#include "profiler.hpp"
+#include "../fitness.hpp"
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace Algorithm::Private {
+
+	//Best solution found by a searcher that can walk away from it (annealing, late acceptance), to end the run with.
+	//The copies are profiled as the bestCopy phase of the searcher.
+	template <class Solution>
+	class BestTracker {
+
+	  public:
+
+		explicit BestTracker(const Profiler &profiler) noexcept : _profiler{profiler} {}
+
+		//start tracking the best solution from the given one
+		void reset(Solution &solution)
+		{
+			const Profiler::Scope _{_profiler, Phase::bestCopy};
+			if (_solutionPtr)
+				*_solutionPtr = solution; //reuse the memory of the previous run
+			else
+				_solutionPtr = std::make_unique<Solution>(solution);
+
+			_fitness = solution.getFitness();
+			_isFeasible = solution.isFeasible();
+		}
+
+		//the solution becomes the best
+		void update(Solution &solution)
+		{
+			const Profiler::Scope _{_profiler, Phase::bestCopy};
+			*_solutionPtr = solution;
+			_fitness = solution.getFitness();
+			_isFeasible = solution.isFeasible();
+		}
+
+		//turn the solution back into the best one
+		void restore(Solution &solution) const
+		{
+			const Profiler::Scope _{_profiler, Phase::bestCopy};
+			solution = *_solutionPtr;
+		}
+
+		//a feasible best solution can only be replaced by a feasible one, if required by config
+		bool isReplaceableBy(Solution &solution, bool keepFeasible) const
+		{
+			return !keepFeasible || !_isFeasible || solution.isFeasible();
+		}
+
+		Fitness fitness() const noexcept { return _fitness; }
+
+	  private:
+
+		const Profiler &_profiler;
+		std::unique_ptr<Solution> _solutionPtr;
+		Fitness _fitness;
+		bool _isFeasible{false};
+	};
+
+	//Returns the fitness of the solution after a walk, which must match the delta reported by the walk.
+	//The searcher names itself for the error message.
+	template <class Solution>
+	Fitness checkWalkFitness(Solution &solution, Fitness original, Fitness::delta_t delta, const Profiler &profiler, const char *searcher)
+	{
+		const Profiler::Scope _{profiler, Phase::fitnessCheck};
+		const Fitness actual{solution.getFitness()};
+		if (actual != original + delta)
+			throw std::logic_error(std::string{searcher} + "::run: unexpected fitness delta after walk. Expected " + std::to_string(delta) + ", got " + std::to_string(actual - original));
+
+		return actual;
+	}
+
+} //ns Algorithm::Private
+
+#endif //file guard
@@ -0,0 +1,98 @@
+#ifndef _algorithm_bounded_queue_included_
+#define _algorithm_bounded_queue_included_
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <type_traits>
+
+namespace Algorithm::Private {
+
+	//Lock-free queue of fixed capacity for multiple producers and consumers (Vyukov's bounded MPMC queue).
+	//Each cell carries a sequence number telling whether it's ready to be written or read in the current lap,
+	//so producers and consumers only contend on their own position counters.
+	template <class T>
+		requires std::is_nothrow_copy_assignable_v<T> && std::is_nothrow_default_constructible_v<T>
+	class BoundedQueue {
+
+	  public:
+
+		//the capacity is rounded up to a power of two
+		explicit BoundedQueue(std::size_t capacity)
+		:
+			_mask{std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity) - 1},
+			_cells{std::make_unique<Cell[]>(_mask + 1)}
+		{
+			for (std::size_t i = 0; i <= _mask; ++i)
+				_cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		BoundedQueue(const BoundedQueue &) = delete;
+		BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+		//returns false if the queue is full
+		bool tryPush(const T &value) noexcept
+		{
+			std::size_t position{_enqueuePosition.load(std::memory_order_relaxed)};
+			for (;;) {
+				Cell &cell = _cells[position & _mask];
+				const std::size_t sequence{cell.sequence.load(std::memory_order_acquire)};
+				const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+				if (difference == 0) {
+					if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+						cell.value = value;
+						cell.sequence.store(position + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (difference < 0)
+					return false; //the cell still holds the value from the previous lap
+				else
+					position = _enqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		//returns nothing if the queue is empty
+		std::optional<T> tryPop() noexcept
+		{
+			std::size_t position{_dequeuePosition.load(std::memory_order_relaxed)};
+			for (;;) {
+				Cell &cell = _cells[position & _mask];
+				const std::size_t sequence{cell.sequence.load(std::memory_order_acquire)};
+				const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+				if (difference == 0) {
+					if (_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+						T value{cell.value};
+						cell.sequence.store(position + _mask + 1, std::memory_order_release);
+						return value;
+					}
+				}
+				else if (difference < 0)
+					return std::nullopt; //the cell wasn't written in this lap yet
+				else
+					position = _dequeuePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		std::size_t capacity() const noexcept { return _mask + 1; }
+
+	  private:
+
+		struct Cell {
+			std::atomic<std::size_t> sequence;
+			T value;
+		};
+
+		static constexpr std::size_t _cacheLine{64};
+
+		const std::size_t _mask;
+		const std::unique_ptr<Cell[]> _cells;
+		alignas(_cacheLine) std::atomic<std::size_t> _enqueuePosition{0};
+		alignas(_cacheLine) std::atomic<std::size_t> _dequeuePosition{0};
+	};
+
+} //ns Algorithm::Private
+
+#endif //file guard
@@ -0,0 +1,121 @@
+#ifndef _algorithm_candidate_set_included_
+#define _algorithm_candidate_set_included_
+
+#include "move_batch.hpp"
+#include "../fitness.hpp"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace Algorithm::TabuSearch {
+
+	//Collects the best acceptable steps offered during evaluation of (a part of) the neighborhood.
+	//Steps are ranked by their adapted delta, all steps sharing the best delta are kept.
+	//Without the acceptance function, all steps offered are kept instead (e.g. for the MoveCache, which ranks them itself).
+	//The acceptance function is called for each competitive step, so its type is a parameter, to be called directly (see StaticSearcher::Acceptance).
+	template <class Step, class Acceptance = std::function<bool(const Step &, Fitness)>>
+	class CandidateSet {
+
+	  public:
+
+		using step_ptr_t = std::shared_ptr<Step>;
+		using acceptance_t = Acceptance;
+
+		CandidateSet() = default;
+
+		explicit CandidateSet(acceptance_t isAcceptable) : _isAcceptable{std::move(isAcceptable)}
+		{
+		}
+
+		//prepare for a new evaluation, keeping the allocated memory
+		void reset(Fitness currentFitness) noexcept
+		{
+			_steps.clear();
+			_bestDelta = AdaptedFitness::worstDelta();
+			_currentFitness = currentFitness;
+		}
+
+		//Returns true if a step with the given adapted delta could make it to the set.
+		//Use it to avoid creating steps that would be thrown away anyway.
+		bool isCompetitive(AdaptedFitness::delta_t adaptedDelta) const noexcept
+		{
+			return adaptedDelta <= _bestDelta;
+		}
+
+		//Offers the step as a candidate, returns true if the step was kept.
+		//Acceptability (tabu and aspiration) is only assessed for competitive steps, as it can be costly.
+		bool offer(const step_ptr_t &step)
+		{
+			if (!_isAcceptable) {
+				_steps.push_back(step); //the best delta stays the worst, so that every step is competitive
+				return true;
+			}
+
+			const auto adaptedDelta = step->adaptedDelta();
+			if (!isCompetitive(adaptedDelta) || !(*_isAcceptable)(*step, _currentFitness))
+				return false;
+
+			if (adaptedDelta < _bestDelta) {
+				_steps.clear();
+				_bestDelta = adaptedDelta;
+			}
+			_steps.push_back(step);
+			return true;
+		}
+
+		//Offers the best acceptable moves of the evaluated batch, creating steps only for them by makeStep(move, delta, adaptedDelta).
+		//The moves of the best adapted delta are offered first, which is usually enough. If none of them is acceptable (e.g. all are tabu),
+		//the remaining competitive moves are offered in a single pass, so the cost stays linear in the size of the batch.
+		//Keeps the same steps as offering each move of the batch in turn. Returns the number of steps kept.
+		template <class Move, class StepMaker>
+		int offer(const MoveBatch<Move> &batch, StepMaker &&makeStep)
+		{
+			int kept{0};
+			if (!_isAcceptable) {
+				for (std::size_t i = 0; i < batch.size(); ++i)
+					kept += offer(makeStep(batch.move(i), batch.delta(i), batch.adaptedDelta(i)));
+
+				return kept;
+			}
+
+			auto const adaptedDeltas = batch.adaptedDeltas();
+			const auto level = batch.minAdaptedDelta();
+			if (level == AdaptedFitness::worstDelta() || !isCompetitive(level))
+				return 0;
+
+			for (std::size_t i = 0; i < adaptedDeltas.size(); ++i) {
+				if (adaptedDeltas[i] == level)
+					kept += offer(makeStep(batch.move(i), batch.delta(i), adaptedDeltas[i]));
+			}
+			if (kept)
+				return kept;
+
+			for (std::size_t i = 0; i < adaptedDeltas.size(); ++i) {
+				if (adaptedDeltas[i] == level || adaptedDeltas[i] == AdaptedFitness::worstDelta() || !isCompetitive(adaptedDeltas[i]))
+					continue;
+
+				const auto bestDelta = _bestDelta;
+				if (offer(makeStep(batch.move(i), batch.delta(i), adaptedDeltas[i])))
+					kept = _bestDelta < bestDelta ? 1 : kept + 1; //a better step replaces the ones kept before
+			}
+			return kept;
+		}
+
+		Fitness currentFitness() const noexcept { return _currentFitness; }
+		AdaptedFitness::delta_t bestDelta() const noexcept { return _bestDelta; }
+		const std::vector<step_ptr_t> &steps() const noexcept { return _steps; }
+
+	  private:
+
+		std::optional<acceptance_t> _isAcceptable; //none keeps all steps
+		std::vector<step_ptr_t> _steps;
+		AdaptedFitness::delta_t _bestDelta{AdaptedFitness::worstDelta()};
+		Fitness _currentFitness;
+	};
+
+} //ns Algorithm::TabuSearch
+
+#endif //file guard
@@ -1,11 +1,29 @@
 #ifndef _algorithm_chained_search_included_
 #define _algorithm_chained_search_included_
 
+#include "algorithm_group.hpp"
 #include "base.hpp"
+#include "checkpoint.hpp"
 #include "config.hpp"
+#include "random.hpp"
+#include "../elite_pool.hpp"
+#include "../events/async_dispatcher.hpp"
 #include "../factory.hpp"
+#include "../interface/icheckpointed.h"
+#include "../interface/iprofiled.h"
 #include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -13,8 +31,14 @@ namespace Algorithm::ChainedSearch {
 
 	//chained local search
 	//Use config to inject algorithms and their configurations as necessary.
+	//The progress can be saved to a checkpoint file periodically and when stopped, and the search resumed from it later (see Config::checkpoint).
+	//A checkpoint is taken between the runs of the child algorithms. It holds the solution, the position in the repeats and cycles, the seed
+	//and the state of the children implementing ICheckpointed, so that resuming continues as if the search was never interrupted.
+	//A search resuming with a drawn seed adopts the seed of the checkpoint, a configured seed must match it.
+	//With an elite pool (see Config::elitePool), the results of the repeats are kept in the pool and the following repeats restart
+	//from its random members instead of the starting solution, so that they build on the good solutions found so far.
 	template <class Solution>
-	class Searcher : public AlgorithmBase<Solution> {
+	class Searcher : public AlgorithmBase<Solution>, public IProfiled {
 
 		using algorithm_ptr_t = typename Private::Factory<Solution>::algorithm_ptr_t;
 
@@ -25,6 +49,24 @@ namespace Algorithm::ChainedSearch {
 			_config.load(pt);
 			_config.repeat = pt.get("repeat", 1);
 			_config.cycles = pt.get("cycles", 4);
+			_config.threads = pt.get("threads", 1);
+			if (_config.threads <= 0)
+				_config.threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+			_config.checkpoint = pt.get<std::string>("checkpoint", "");
+			_config.checkpointInterval = std::chrono::seconds{pt.get("checkpointInterval", 60)};
+			_config.resume = pt.get("resume", false);
+			if (!_config.checkpoint.empty() && _config.threads > 1 && _config.repeat > 1)
+				throw std::runtime_error("Algorithm::ChainedSearch::Searcher: checkpoints are not supported with parallel repeats");
+
+			_config.elitePool = pt.get("elitePool", 0);
+			_config.eliteDistance = pt.get("eliteDistance", 1);
+			if (_config.elitePool > 0) {
+				if constexpr (Storage::EliteSolution<Solution>)
+					_elitePool = std::make_unique<Storage::ElitePool<Solution>>(_config.elitePool, _config.eliteDistance);
+				else
+					throw std::runtime_error("Algorithm::ChainedSearch::Searcher: elite pool requires solutions with distance(), hash() or equality comparison");
+			}
 
 			if (pt.count("initial")) {
 				auto const &initNode = pt.get_child("initial");
@@ -38,27 +80,34 @@ namespace Algorithm::ChainedSearch {
 				);
 			}
 
-			for (auto &algDef : _config.algorithms) {
+			for (auto &algDef : _config.algorithms)
 				_config.propagate(algDef.second);
-				auto alg = SingleFactory<Solution>::Instance().createAlgorithm(algDef.first, algDef.second, this);
-				_algorithms.push_back(std::move(alg));
-			}
+
+			_chain.algorithms = _createAlgorithms(this, _config.seed);
+			_chain.extended = _config.extended;
+			_resumePending = _config.resume;
 		}
 
 		void enableExtensions() final
 		{
-			for (auto const &alg : _algorithms)
-				alg->enableExtensions();
-
-			Ctoolhu::Event::Fire<Algorithm::Events::ExtensionsEnabled>();
+			_setExtensions(_chain, true);
 		}
 
 		void disableExtensions() final
 		{
-			for (auto const &alg : _algorithms)
-				alg->disableExtensions();
+			_setExtensions(_chain, false);
+		}
+
+		//results of the repeats of the last run, null if there's no elite pool
+		const Storage::ElitePool<Solution> *getElitePool() const noexcept { return _elitePool.get(); }
 
-			Ctoolhu::Event::Fire<Algorithm::Events::ExtensionsDisabled>();
+		//stats of all the child algorithms run so far, including those of the parallel repeats
+		Stats getStats() const final
+		{
+			std::lock_guard _{_statsMutex};
+			Stats stats{_stats};
+			_addStats(stats, _chain);
+			return stats;
 		}
 
 	  private:
@@ -68,63 +117,435 @@ namespace Algorithm::ChainedSearch {
 		struct Config : Algorithm::Config {
 			int repeat; //indicates how many times should the algorithm be repeated from the starting point (if solution isn't found)
 			int cycles; //indicates how many times the child algorithms will be run in a loop on the same solution in case of no improvement
+			int threads; //how many repeats can run concurrently (zero or less means one per hardware thread)
 			algorithm_def_t initial; //name of initial algorithm run once (usually some kind of a generation algorithm)
 			std::vector<algorithm_def_t> algorithms;
 				//chain of algorithms run in cycles until stopping condition is met
+			std::string checkpoint; //file the progress is saved to, no checkpoints if empty
+			std::chrono::seconds checkpointInterval; //minimum time between checkpoints, besides the one taken at the end
+			bool resume; //continue from the checkpoint file in the first run, if the file exists
+			int elitePool; //how many of the best distinct results of the repeats are kept to restart the repeats from, no pool if zero
+			int eliteDistance; //minimum distance of the solutions in the elite pool (if the solutions measure it, otherwise they only have to differ)
+		};
+
+		//algorithm instances running a repeat
+		struct Chain {
+			algorithm_ptr_t initial;
+			std::vector<algorithm_ptr_t> algorithms;
+			bool extended; //whether the algorithms have their extensions enabled
+		};
+
+		//position of the search in its repeats and cycles, saved in checkpoints
+		struct Progress {
+			int repeat{0};
+			int cycles; //how many idle cycles end the repeat, halved when the extensions kick in
+			int idleCycles{0};
+			int next{0}; //algorithm of the chain to run next
+			bool running{false}; //the repeat has started, i.e. its initial algorithm has run
+			bool extended{false}; //the extensions were enabled by the meta-logic
+		};
+
+		//taking checkpoints in a sequential run
+		struct Checkpointing {
+			const Solution *stored; //the starting solution of the repeats, null if there's only one
+			std::chrono::milliseconds last; //time of the last checkpoint
 		};
 
 		bool _run(Solution &solution) final
 		{
+			if (_config.threads > 1 && _config.repeat > 1)
+				return _runParallel(solution);
+
 			const Fitness starting{solution.getFitness()};
-			auto storedSolutionPtr = std::make_unique<Solution>(solution); //don't use the stack as we don't know the size of the solution
-
-			algorithm_ptr_t initialAlgorithm;
-			if (!_config.initial.first.empty())
-				initialAlgorithm = SingleFactory<Solution>::Instance().createAlgorithm(_config.initial.first, _config.initial.second, this);
-
-			while (!this->isStopRequested() && !solution.getFitness().isZero() && _config.repeat-- > 0) {
-				solution = *storedSolutionPtr;
-				if (initialAlgorithm)
-					initialAlgorithm->start(solution);
-
-				bool extended{_config.extended};
-				if (extended)
-					enableExtensions();
-
-				int idleCycles{0};
-				while (!this->isStopRequested() && !solution.getFitness().isZero()) {
-					idleCycles++;
-					for (auto const &alg : _algorithms) {
-						if (alg->start(solution))
-							idleCycles = 0;
-					}
+			std::unique_ptr<Solution> storedSolutionPtr; //don't use the stack as we don't know the size of the solution
+			if (_config.repeat > 1)
+				storedSolutionPtr = std::make_unique<Solution>(solution); //only needed to restart the repeats after the first one
+
+			{
+				std::lock_guard _{_statsMutex};
+				if (_chain.initial)
+					_addStats(_stats, _chain.initial);
+
+				_chain.initial = _createInitialAlgorithm(this, _config.seed);
+			}
+
+			//the progress is local, so that the search behaves the same when started again (e.g. as a child of another algorithm)
+			Progress progress{.cycles = _config.cycles};
+			if (_elitePool)
+				_elitePool->clear(); //likewise the elite pool, which is restored when resuming
+
+			if (_resumePending) {
+				_resumePending = false;
+				if (std::filesystem::exists(_config.checkpoint))
+					_loadCheckpoint(solution, storedSolutionPtr.get(), progress);
+			}
+
+			Checkpointing checkpointing{storedSolutionPtr.get(), this->elapsedTime()};
+			while (!this->isStopRequested() && !solution.getFitness().isZero() && progress.repeat < _config.repeat) {
+				if (progress.repeat > 0 && !progress.running)
+					_restart(solution, *storedSolutionPtr, progress.repeat);
 
-					//apply some meta-logic
-					if (!_config.extended && solution.isFeasible()) {
-						//save time by disabling extensions once a feasible solution is found
-						extended = false;
-						disableExtensions();
+				if (!_runRepeat(solution, _chain, progress, *this, _config.checkpoint.empty() ? nullptr : &checkpointing))
+					break; //stopped, the repeat is to be continued when resumed
+
+				_offerToElite(solution);
+				progress.repeat++;
+				progress.running = false;
+			}
+
+			if (!_config.checkpoint.empty())
+				_saveCheckpoint(solution, storedSolutionPtr.get(), progress);
+
+			//the last repeat might not have ended with the best result
+			if (auto const best = _elitePool ? _elitePool->best() : nullptr; best && best->fitness < solution.getFitness()) {
+				solution = best->solution;
+				Algorithm::Events::publish<Solution>(Algorithm::Events::CurrentSolutionChanged { &solution, this->elapsedTime() });
+			}
+			return solution.getFitness() < starting;
+		}
+
+		//Runs the repeats concurrently, each with its own copy of the solution and its own instances of the algorithms.
+		//The best result is kept. Once a thread reaches zero fitness, the other repeats are stopped.
+		//The random streams of each repeat's algorithms are derived from the repeat number, so that the result doesn't depend on which thread ran it.
+		//That doesn't hold with an elite pool, as the members a repeat can restart from depend on which repeats have finished before.
+		//The progress events of the repeats are silenced, only the merged result is published, from the calling thread.
+		//The events the child algorithms fire synchronously to react to their steps (e.g. StepExecuted) still come from the worker threads,
+		//with their copies of the solution, so their listeners must be thread-safe.
+		bool _runParallel(Solution &solution)
+		{
+			const Fitness starting{solution.getFitness()};
+			const auto storedSolutionPtr = std::make_unique<const Solution>(solution);
+			if (_elitePool)
+				_elitePool->clear();
+
+			Private::AlgorithmGroup group{*this};
+			std::mutex resultMutex;
+			std::unique_ptr<Solution> bestSolutionPtr;
+			int bestRepeat{0};
+			std::exception_ptr error;
+			std::atomic<int> nextRepeat{0};
+
+			auto const work = [&] {
+				const Algorithm::Events::Silenced silenced;
+				try {
+					std::unique_ptr<Solution> solutionPtr;
+					for (int repeat = nextRepeat++; repeat < _config.repeat && !group.isStopRequested(); repeat = nextRepeat++) {
+						if (!solutionPtr)
+							solutionPtr = std::make_unique<Solution>(*storedSolutionPtr);
+						_restart(*solutionPtr, *storedSolutionPtr, repeat);
+
+						Progress progress{.repeat = repeat, .cycles = _config.cycles}; //not carried over from the previous repeat of the thread, which could be any
+						const std::uint64_t seed{Private::deriveSeed(_config.seed, repeat)};
+						Chain chain{_createInitialAlgorithm(&group, seed), _createAlgorithms(&group, seed), _config.extended};
+						if (_runRepeat(*solutionPtr, chain, progress, group, nullptr))
+							_offerToElite(*solutionPtr);
+						{
+							std::lock_guard _{_statsMutex};
+							_addStats(_stats, chain);
+						}
+
+						const Fitness result{solutionPtr->getFitness()};
+						std::lock_guard _{resultMutex};
+						if (!bestSolutionPtr || result < bestSolutionPtr->getFitness() || (result == bestSolutionPtr->getFitness() && repeat < bestRepeat)) {
+							//prefer earlier repeats on ties, so that the result doesn't depend on thread scheduling
+							std::swap(bestSolutionPtr, solutionPtr);
+							bestRepeat = repeat;
+						}
+						if (result.isZero())
+							group.stopAsync();
 					}
-					if (!extended && !solution.isFeasible() && idleCycles == _config.cycles) {
-						//we're at the end and feasible solution wasn't found - re-run algorithms with extensions enabled
-						extended = true;
-						enableExtensions();
-						idleCycles = 0;
-
-						//reduce the number of cycles to save time - if a better solution isn't found with extensions then it's probably worthless to continue cycling a lot
-						if (_config.cycles > 1)
-							_config.cycles /= 2;
+				}
+				catch (...) {
+					std::lock_guard _{resultMutex};
+					if (!error)
+						error = std::current_exception();
+
+					group.stopAsync();
+				}
+			};
+
+			std::vector<std::thread> threads;
+			for (int i = 0; i < std::min(_config.threads, _config.repeat); ++i)
+				threads.emplace_back(work);
+
+			for (auto &thread : threads)
+				thread.join();
+
+			if (error)
+				std::rethrow_exception(error);
+
+			if (!bestSolutionPtr)
+				return false; //stopped before any repeat was finished
+
+			solution = *bestSolutionPtr;
+			Algorithm::Events::publish<Solution>(Algorithm::Events::CurrentSolutionChanged { &solution, this->elapsedTime() });
+			if (solution.getFitness() >= starting)
+				return false;
+
+			Algorithm::Events::publish<Solution>(Algorithm::Events::BestSolutionFound { &solution, this->elapsedTime() });
+			return true;
+		}
+
+		//Runs the chain on the solution until it can't be improved further, continuing from the given progress.
+		//Stop requests are taken from the controller, which is the parent of the chain's algorithms.
+		//Checkpoints are taken after the runs of the algorithms, if enabled.
+		//Returns false if stopped before the end of the repeat.
+		bool _runRepeat(Solution &solution, Chain &chain, Progress &progress, const IAlgorithm &controller, Checkpointing *checkpointing)
+		{
+			if (!progress.running) {
+				if (chain.initial)
+					chain.initial->start(solution);
+
+				progress.running = true;
+				progress.idleCycles = 0;
+				progress.next = 0;
+				progress.extended = _config.extended;
+				if (progress.extended)
+					_setExtensions(chain, true);
+			}
+
+			while (!controller.isStopRequested() && !solution.getFitness().isZero()) {
+				if (progress.next == 0)
+					progress.idleCycles++;
+
+				while (progress.next < static_cast<int>(chain.algorithms.size())) {
+					if (chain.algorithms[progress.next++]->start(solution))
+						progress.idleCycles = 0;
+
+					if (checkpointing && this->elapsedTime() - checkpointing->last >= _config.checkpointInterval) {
+						_saveCheckpoint(solution, checkpointing->stored, progress);
+						checkpointing->last = this->elapsedTime();
 					}
+				}
+				progress.next = 0;
+
+				//apply some meta-logic
+				if (!_config.extended && solution.isFeasible()) {
+					//save time by disabling extensions once a feasible solution is found
+					progress.extended = false;
+					_setExtensions(chain, false);
+				}
+				if (!progress.extended && !solution.isFeasible() && progress.idleCycles == progress.cycles) {
+					//we're at the end and feasible solution wasn't found - re-run algorithms with extensions enabled
+					progress.extended = true;
+					_setExtensions(chain, true);
+					progress.idleCycles = 0;
 
-					if (_config.cycles >= 0 && _config.cycles <= idleCycles)
-						break;
+					//reduce the number of cycles to save time - if a better solution isn't found with extensions then it's probably worthless to continue cycling a lot
+					if (progress.cycles > 1)
+						progress.cycles /= 2;
 				}
+
+				if (progress.cycles >= 0 && progress.cycles <= progress.idleCycles)
+					return true;
 			}
-			return solution.getFitness() < starting;
+			return solution.getFitness().isZero();
+		}
+
+		//Sets the starting solution of the repeat.
+		//The repeats after the first one start from a random member of the elite pool, if there's one.
+		//The member is drawn from a stream derived from the seed and the repeat, so a resumed search draws the same one,
+		//as long as it resumes with the same seed (which the checkpoints save) and the same pool.
+		void _restart(Solution &solution, const Solution &stored, int repeat) const
+		{
+			if (repeat > 0 && _elitePool) {
+				Private::FastRandom random{Private::deriveSeed(Private::deriveSeed(_config.seed, repeat), _config.algorithms.size() + 1)};
+				if (auto const member = _elitePool->sample(random)) {
+					solution = member->solution;
+					return;
+				}
+			}
+			solution = stored;
+		}
+
+		void _offerToElite(Solution &solution)
+		{
+			if constexpr (Storage::EliteSolution<Solution>) {
+				if (_elitePool)
+					_elitePool->insert(solution);
+			}
+		}
+
+		void _setExtensions(Chain &chain, bool enable)
+		{
+			chain.extended = enable;
+			for (auto const &alg : chain.algorithms) {
+				if (enable)
+					alg->enableExtensions();
+				else
+					alg->disableExtensions();
+			}
+
+			if (enable)
+				Algorithm::Events::publish<Solution>(Algorithm::Events::ExtensionsEnabled{});
+			else
+				Algorithm::Events::publish<Solution>(Algorithm::Events::ExtensionsDisabled{});
+		}
+
+		void _saveCheckpoint(const Solution &solution, const Solution *stored, const Progress &progress) const
+		{
+			Checkpoint::Writer out;
+
+			//identification of the configuration
+			out.write(static_cast<std::int32_t>(_config.repeat));
+			out.write(static_cast<std::uint64_t>(_config.algorithms.size()));
+			for (auto const &algDef : _config.algorithms)
+				out.write(algDef.first);
+
+			out.write(static_cast<std::int32_t>(progress.repeat));
+			out.write(static_cast<std::int32_t>(progress.cycles));
+			out.write(static_cast<std::int32_t>(progress.idleCycles));
+			out.write(static_cast<std::int32_t>(progress.next));
+			out.write(progress.running);
+			out.write(progress.extended);
+			out.write(_config.seed); //the initial algorithm and the elite draws of the following repeats depend on it
+			out.write(_chain.extended);
+			_saveState(out, _chain.initial);
+			for (auto const &alg : _chain.algorithms)
+				_saveState(out, alg);
+
+			Checkpoint::save(out, solution);
+			out.write(stored != nullptr);
+			if (stored)
+				Checkpoint::save(out, *stored);
+
+			std::vector<typename Storage::ElitePool<Solution>::member_ptr_t> elite;
+			if (_elitePool)
+				elite = _elitePool->members();
+
+			out.write(static_cast<std::uint64_t>(elite.size()));
+			for (auto const &member : elite)
+				Checkpoint::save(out, member->solution);
+
+			out.saveTo(_config.checkpoint);
+		}
+
+		void _loadCheckpoint(Solution &solution, Solution *stored, Progress &progress)
+		{
+			Checkpoint::Reader in{_config.checkpoint};
+			bool matches{in.read<std::int32_t>() == _config.repeat && in.read<std::uint64_t>() == _config.algorithms.size()};
+			for (std::size_t i = 0; matches && i < _config.algorithms.size(); ++i)
+				matches = in.readString() == _config.algorithms[i].first;
+
+			if (!matches)
+				throw std::runtime_error("Algorithm::ChainedSearch::Searcher::_loadCheckpoint: " + _config.checkpoint + " was saved with another configuration");
+
+			progress.repeat = in.read<std::int32_t>();
+			progress.cycles = in.read<std::int32_t>();
+			progress.idleCycles = in.read<std::int32_t>();
+			progress.next = in.read<std::int32_t>();
+			progress.running = in.read<bool>();
+			progress.extended = in.read<bool>();
+			if (const auto seed = in.read<std::uint64_t>(); seed != _config.seed) {
+				if (!_config.seedDrawn)
+					throw std::runtime_error("Algorithm::ChainedSearch::Searcher::_loadCheckpoint: " + _config.checkpoint + " was saved with another seed");
+
+				//continue with the seed drawn by the interrupted search instead of the one drawn now
+				_config.seed = seed;
+				std::lock_guard _{_statsMutex};
+				_chain.initial = _createInitialAlgorithm(this, seed);
+				_chain.algorithms = _createAlgorithms(this, seed);
+				_chain.extended = _config.extended;
+			}
+			if (const bool extended{in.read<bool>()}; extended != _chain.extended)
+				_setExtensions(_chain, extended);
+
+			_loadState(in, _chain.initial);
+			for (auto const &alg : _chain.algorithms)
+				_loadState(in, alg);
+
+			Checkpoint::load(in, solution);
+			if (in.read<bool>()) {
+				if (!stored)
+					throw std::logic_error("Algorithm::ChainedSearch::Searcher::_loadCheckpoint: unexpected starting solution of the repeats");
+
+				Checkpoint::load(in, *stored);
+			}
+
+			const auto eliteCount = in.read<std::uint64_t>();
+			if (eliteCount > 0 && !_elitePool)
+				throw std::runtime_error("Algorithm::ChainedSearch::Searcher::_loadCheckpoint: " + _config.checkpoint + " was saved with an elite pool");
+
+			for (std::uint64_t i = 0; i < eliteCount; ++i) {
+				Solution member{solution};
+				Checkpoint::load(in, member);
+				_offerToElite(member);
+			}
+			if (!in.atEnd())
+				throw std::runtime_error("Algorithm::ChainedSearch::Searcher::_loadCheckpoint: unexpected data at the end of " + _config.checkpoint);
+
+			Algorithm::Events::publish<Solution>(Algorithm::Events::CurrentSolutionChanged { &solution, this->elapsedTime() });
+		}
+
+		//the state of the algorithm in a block of its own, if it can save it
+		static void _saveState(Checkpoint::Writer &out, const algorithm_ptr_t &alg)
+		{
+			auto const checkpointed = dynamic_cast<const ICheckpointed *>(alg.get());
+			out.write(checkpointed != nullptr);
+			if (checkpointed) {
+				const std::size_t block{out.beginBlock()};
+				checkpointed->saveState(out);
+				out.endBlock(block);
+			}
+		}
+
+		static void _loadState(Checkpoint::Reader &in, const algorithm_ptr_t &alg)
+		{
+			if (!in.read<bool>())
+				return;
+
+			auto const checkpointed = dynamic_cast<ICheckpointed *>(alg.get());
+			if (!checkpointed)
+				throw std::runtime_error("Algorithm::ChainedSearch::Searcher::_loadCheckpoint: " + (alg ? alg->name() : std::string{"missing initial algorithm"}) + " can't load its state");
+
+			const std::size_t remaining{in.beginBlock()};
+			checkpointed->loadState(in);
+			in.endBlock(remaining);
+		}
+
+		static void _addStats(Stats &stats, const Chain &chain)
+		{
+			if (chain.initial)
+				_addStats(stats, chain.initial);
+
+			for (auto const &alg : chain.algorithms)
+				_addStats(stats, alg);
+		}
+
+		static void _addStats(Stats &stats, const algorithm_ptr_t &alg)
+		{
+			if (auto const profiled = dynamic_cast<const IProfiled *>(alg.get()))
+				stats += profiled->getStats();
+		}
+
+		//the seed is the root of the random streams of the created algorithms
+		algorithm_ptr_t _createInitialAlgorithm(IAlgorithm *parent, std::uint64_t seed) const
+		{
+			if (_config.initial.first.empty())
+				return nullptr;
+
+			auto config = _config.initial.second;
+			Config::propagateSeed(config, seed, _config.algorithms.size());
+			return SingleFactory<Solution>::Instance().createAlgorithm(_config.initial.first, config, parent);
+		}
+
+		std::vector<algorithm_ptr_t> _createAlgorithms(IAlgorithm *parent, std::uint64_t seed) const
+		{
+			std::vector<algorithm_ptr_t> algorithms;
+			for (std::size_t i = 0; i < _config.algorithms.size(); ++i) {
+				auto config = _config.algorithms[i].second;
+				Config::propagateSeed(config, seed, i);
+				algorithms.push_back(SingleFactory<Solution>::Instance().createAlgorithm(_config.algorithms[i].first, config, parent));
+			}
+			return algorithms;
 		}
 
-		std::vector<algorithm_ptr_t> _algorithms;
+		Chain _chain;
 		Config _config;
+		std::unique_ptr<Storage::ElitePool<Solution>> _elitePool; //results of the repeats, if enabled
+		bool _resumePending; //the checkpoint is yet to be loaded
+		Stats _stats; //of the algorithms no longer in the chain
+		mutable std::mutex _statsMutex;
 	};
 
 } //ns Algorithm::ChainedSearch
@@ -0,0 +1,241 @@
+#ifndef _algorithm_checkpoint_included_
+#define _algorithm_checkpoint_included_
+
+#include "../interface/isolution.h"
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//Versioned binary format of the search checkpoints.
+//The values are stored as they are in memory (native byte order), after a header identifying the format, its version and the byte order.
+//Checkpoints are meant for resuming on the same kind of machine, they are rejected if the byte order doesn't match.
+namespace Algorithm::Checkpoint {
+
+	inline constexpr std::array<char, 4> magic{'L', 'S', 'C', 'P'};
+	inline constexpr std::uint32_t version{3};
+	inline constexpr std::uint32_t byteOrderMark{0x01020304};
+
+	//builds the checkpoint in memory, then saves it at once
+	class Writer {
+
+	  public:
+
+		Writer()
+		{
+			write(magic);
+			write(version);
+			write(byteOrderMark);
+		}
+
+		template <class T>
+			requires std::is_trivially_copyable_v<T>
+		void write(const T &value)
+		{
+			auto const bytes = reinterpret_cast<const std::byte *>(&value);
+			_data.insert(_data.end(), bytes, bytes + sizeof(T));
+		}
+
+		//preceded by the number of elements
+		template <class T>
+			requires std::is_trivially_copyable_v<T>
+		void write(std::span<const T> values)
+		{
+			write(static_cast<std::uint64_t>(values.size()));
+			auto const bytes = reinterpret_cast<const std::byte *>(values.data());
+			_data.insert(_data.end(), bytes, bytes + values.size_bytes());
+		}
+
+		template <class T>
+		void write(const std::vector<T> &values)
+		{
+			write(std::span<const T>{values});
+		}
+
+		void write(const std::string &value)
+		{
+			write(std::span<const char>{value});
+		}
+
+		//Starts a block of data preceded by its size, so that it can be checked on reading.
+		//Returns the position to pass to endBlock.
+		std::size_t beginBlock()
+		{
+			const std::size_t position{_data.size()};
+			write(std::uint64_t{0});
+			return position;
+		}
+
+		void endBlock(std::size_t position) noexcept
+		{
+			const std::uint64_t size{_data.size() - position - sizeof(std::uint64_t)};
+			std::memcpy(_data.data() + position, &size, sizeof(size));
+		}
+
+		//Writes to a temporary file first, which then replaces the given one,
+		//so that a crash while saving doesn't leave a broken checkpoint behind.
+		void saveTo(const std::string &path) const
+		{
+			const std::string temporary{path + ".tmp"};
+			{
+				std::ofstream file{temporary, std::ios::binary | std::ios::trunc};
+				file.write(reinterpret_cast<const char *>(_data.data()), static_cast<std::streamsize>(_data.size()));
+				if (!file.flush())
+					throw std::runtime_error("Algorithm::Checkpoint::Writer::saveTo: cannot write " + temporary);
+			}
+			std::filesystem::rename(temporary, path);
+		}
+
+		std::span<const std::byte> data() const noexcept { return _data; }
+
+	  private:
+
+		std::vector<std::byte> _data;
+	};
+
+	//Reads the checkpoint from memory, or from a file mapped to memory, so that it isn't copied as a whole.
+	//Throws std::runtime_error if the data ends prematurely or isn't a checkpoint of this version.
+	class Reader {
+
+	  public:
+
+		explicit Reader(std::span<const std::byte> data) : _data{data}
+		{
+			_readHeader();
+		}
+
+		explicit Reader(const std::string &path)
+		{
+			try {
+				_file = std::make_unique<boost::interprocess::file_mapping>(path.c_str(), boost::interprocess::read_only);
+				_region = std::make_unique<boost::interprocess::mapped_region>(*_file, boost::interprocess::read_only);
+			}
+			catch (const boost::interprocess::interprocess_exception &e) {
+				throw std::runtime_error("Algorithm::Checkpoint::Reader: cannot map " + path + ": " + e.what());
+			}
+			_data = {static_cast<const std::byte *>(_region->get_address()), _region->get_size()};
+			_readHeader();
+		}
+
+		template <class T>
+			requires std::is_trivially_copyable_v<T>
+		T read()
+		{
+			T value;
+			std::memcpy(&value, _take(sizeof(T)), sizeof(T));
+			return value;
+		}
+
+		//reads elements written as a span
+		template <class T>
+			requires std::is_trivially_copyable_v<T>
+		void read(std::vector<T> &values)
+		{
+			const auto count = read<std::uint64_t>();
+			if (count > _data.size() / sizeof(T))
+				throw std::runtime_error("Algorithm::Checkpoint::Reader: unexpected end of data");
+
+			values.resize(count);
+			std::memcpy(values.data(), _take(count * sizeof(T)), count * sizeof(T));
+		}
+
+		std::string readString()
+		{
+			const auto size = read<std::uint64_t>();
+			auto const chars = reinterpret_cast<const char *>(_take(size));
+			return std::string(chars, size);
+		}
+
+		//Starts reading a block written between Writer::beginBlock and endBlock.
+		//Returns the size of the data after the block, to pass to endBlock.
+		std::size_t beginBlock()
+		{
+			const auto size = read<std::uint64_t>();
+			if (size > _data.size())
+				throw std::runtime_error("Algorithm::Checkpoint::Reader: unexpected end of data");
+
+			return _data.size() - size;
+		}
+
+		//checks that exactly the whole block was read
+		void endBlock(std::size_t remaining) const
+		{
+			if (_data.size() != remaining)
+				throw std::runtime_error("Algorithm::Checkpoint::Reader: block size mismatch");
+		}
+
+		bool atEnd() const noexcept { return _data.empty(); }
+
+	  private:
+
+		void _readHeader()
+		{
+			if (read<std::array<char, 4>>() != magic)
+				throw std::runtime_error("Algorithm::Checkpoint::Reader: not a checkpoint");
+			if (read<std::uint32_t>() != version)
+				throw std::runtime_error("Algorithm::Checkpoint::Reader: unsupported checkpoint version");
+			if (read<std::uint32_t>() != byteOrderMark)
+				throw std::runtime_error("Algorithm::Checkpoint::Reader: checkpoint was saved with another byte order");
+		}
+
+		//consumes the bytes, the data holds what remains to be read
+		const std::byte *_take(std::size_t size)
+		{
+			if (size > _data.size())
+				throw std::runtime_error("Algorithm::Checkpoint::Reader: unexpected end of data");
+
+			auto const bytes = _data.data();
+			_data = _data.subspan(size);
+			return bytes;
+		}
+
+		std::unique_ptr<boost::interprocess::file_mapping> _file;
+		std::unique_ptr<boost::interprocess::mapped_region> _region;
+		std::span<const std::byte> _data; //remaining to be read
+	};
+
+	//in its binary form if it has one, otherwise through the property tree
+	template <class Solution>
+	void save(Writer &out, const Solution &solution)
+	{
+		if constexpr (BinarySolution<Solution>)
+			solution.save(out);
+		else {
+			boost::property_tree::ptree pt;
+			solution.save(pt);
+			std::ostringstream json;
+			boost::property_tree::write_json(json, pt, false);
+			out.write(json.str());
+		}
+	}
+
+	template <class Solution>
+	void load(Reader &in, Solution &solution)
+	{
+		if constexpr (BinarySolution<Solution>)
+			solution.load(in);
+		else {
+			std::istringstream json{in.readString()};
+			boost::property_tree::ptree pt;
+			boost::property_tree::read_json(json, pt);
+			solution.load(pt);
+		}
+	}
+
+} //ns Algorithm::Checkpoint
+
+#endif //file guard
@@ -4,7 +4,10 @@
 #ifndef _algorithm_config_included_
 #define _algorithm_config_included_
 
+#include "random.hpp"
 #include <boost/property_tree/ptree.hpp>
+#include <cstdint>
+#include <random>
 
 namespace Algorithm {
 
@@ -15,12 +18,23 @@ namespace Algorithm {
 		bool keepFeasible{false};
 		bool extended{false}; //can be used to enable extra measures to maximize the searching potential, at the cost of time
 		bool benchmark{false}; //let the algorithm know benchmark mode is required (e.g. to disable seeding random engine)
+		bool profile{false}; //collect time and counts of the search phases (see IProfiled)
+		std::uint64_t seed{0}; //root of the random streams of the algorithm and its children (from the system entropy source unless configured or in benchmark mode)
+		bool seedDrawn{false}; //the seed came from the system entropy source, so a resumed search can adopt the seed of the interrupted one
 
 		void load(const boost::property_tree::ptree &pt)
 		{
 			keepFeasible = pt.get("keepFeasible", false);
 			extended = pt.get("extended", false);
 			benchmark = pt.get("benchmark", false);
+			profile = pt.get("profile", false);
+			seedDrawn = false;
+			if (auto const configured = pt.get_optional<std::uint64_t>("seed"))
+				seed = *configured;
+			else if (!benchmark) {
+				seed = (std::uint64_t{std::random_device{}()} << 32) ^ std::random_device{}();
+				seedDrawn = true;
+			}
 		}
 
 		void propagate(boost::property_tree::ptree &dst) const
@@ -28,6 +42,15 @@ namespace Algorithm {
 			dst.add("keepFeasible", keepFeasible);
 			dst.add("extended", extended);
 			dst.add("benchmark", benchmark);
+			dst.add("profile", profile);
+		}
+
+		//Gives the child algorithm its own random stream, derived from the given seed (ours or one derived from it) and the child's number.
+		//A seed configured explicitly for the child is kept.
+		static void propagateSeed(boost::property_tree::ptree &dst, std::uint64_t seed, std::uint64_t child)
+		{
+			if (!dst.count("seed"))
+				dst.put("seed", Private::deriveSeed(seed, child));
 		}
 	};
 
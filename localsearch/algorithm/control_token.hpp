@@ -0,0 +1,115 @@
+#ifndef _algorithm_control_token_included_
+#define _algorithm_control_token_included_
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace Algorithm::Private {
+
+	//Stop and pause state of an algorithm, linked to the tokens of its ancestors.
+	//Makes it possible to find out that none of the algorithms in a chain is stopped or paused
+	//with a single relaxed load, without any locking or virtual calls.
+	//The flags are pushed down to the tokens of the descendants when set, which is rare, so the checks don't need to walk the chain.
+	class ControlToken {
+
+	  public:
+
+		enum Flag : unsigned {
+			stopped = 1,
+			paused = 2,
+			detached = 4 //the parent has no token, so the chain can't be assessed by tokens alone
+		};
+
+		ControlToken() = default;
+		ControlToken(const ControlToken &) = delete;
+		ControlToken &operator=(const ControlToken &) = delete;
+
+		~ControlToken()
+		{
+			std::lock_guard _{_treeMutex};
+			_unlink();
+			for (auto child : _children) {
+				child->_parent = nullptr;
+				child->_update();
+			}
+		}
+
+		void set(Flag flag, bool on) noexcept
+		{
+			std::lock_guard _{_treeMutex};
+			if (on)
+				_own.fetch_or(flag, std::memory_order_relaxed);
+			else
+				_own.fetch_and(~static_cast<unsigned>(flag), std::memory_order_relaxed);
+
+			_update();
+		}
+
+		//whether the flag is set on this token itself, not inherited from an ancestor
+		bool has(Flag flag) const noexcept
+		{
+			return (_own.load(std::memory_order_relaxed) & flag) != 0;
+		}
+
+		//Returns true if neither this nor any ancestor is stopped or paused.
+		//False doesn't necessarily mean a stop, the state must then be assessed the slow way.
+		bool isClear() const noexcept
+		{
+			return _state.load(std::memory_order_relaxed) == 0;
+		}
+
+		//to be called when the parent of the owning algorithm changes (parent token is null if the parent doesn't have one)
+		void setParent(const ControlToken *parentToken, bool hasParent) noexcept
+		{
+			std::lock_guard _{_treeMutex};
+			_unlink();
+			_parent = parentToken;
+			if (_parent)
+				_parent->_children.push_back(this);
+
+			if (hasParent && !parentToken)
+				_own.fetch_or(detached, std::memory_order_relaxed);
+			else
+				_own.fetch_and(~static_cast<unsigned>(detached), std::memory_order_relaxed);
+
+			_update();
+		}
+
+	  private:
+
+		//recomputes the state from the own flags and the parent's state and pushes it down to the descendants, under the tree mutex
+		void _update() noexcept
+		{
+			const unsigned state{_own.load(std::memory_order_relaxed) | (_parent ? _parent->_state.load(std::memory_order_relaxed) : 0u)};
+			if (state == _state.load(std::memory_order_relaxed))
+				return;
+
+			_state.store(state, std::memory_order_relaxed);
+			for (auto child : _children)
+				child->_update();
+		}
+
+		//removes the token from the children of its parent, under the tree mutex
+		void _unlink() noexcept
+		{
+			if (!_parent)
+				return;
+
+			auto &siblings = _parent->_children;
+			siblings.erase(std::find(siblings.begin(), siblings.end(), this));
+			_parent = nullptr;
+		}
+
+		static inline std::mutex _treeMutex; //guards the links between the tokens, shared as the flags are set rarely
+
+		std::atomic<unsigned> _own{0}; //flags set on this token
+		std::atomic<unsigned> _state{0}; //own flags and those of the ancestors
+		const ControlToken *_parent{nullptr};
+		mutable std::vector<ControlToken *> _children; //registered by the children themselves, hence mutable
+	};
+
+} //ns Algorithm::Private
+
+#endif //file guard
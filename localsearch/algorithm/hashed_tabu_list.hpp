@@ -0,0 +1,188 @@
+#ifndef _algorithm_hashed_tabu_list_included
+#define _algorithm_hashed_tabu_list_included
+
+#include "random.hpp"
+#include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace Algorithm::TabuSearch {
+
+	//Steps usable with the HashedTabuList describe their effect by hashable attribute keys instead of pairwise comparisons:
+	//tabuKey() identifies the attribute the step establishes (e.g. lesson X placed in slot Y),
+	//undoKey() identifies the attribute the step removes, i.e. the tabuKey of any step that would undo this one.
+	//Optionally, shortTermKey() replaces tabuKey() in the short-term tabu comparison.
+	template <class Step>
+	concept HashedTabuStep = requires(const Step &step) {
+		{ step.tabuKey() } -> std::convertible_to<std::size_t>;
+		{ step.undoKey() } -> std::convertible_to<std::size_t>;
+	};
+
+	//Tabu list with constant-time lookups.
+	//Instead of keeping the steps, it remembers the iteration in which the attribute removed by each step stops being tabu,
+	//so there's nothing to decrement when shifting and nothing to scan when checking.
+	//The tabu tenures are drawn from the random engine of the searcher, which must outlive the list.
+	template <class Step>
+	class HashedTabuList {
+
+		static_assert(HashedTabuStep<Step>, "Algorithm::TabuSearch::HashedTabuList: step must provide tabuKey() and undoKey()");
+
+	  public:
+
+		HashedTabuList(const boost::property_tree::ptree &pt, Private::FastRandom &random)
+		:
+			_random{random}
+		{
+			_configure(pt);
+			_slots.resize(_initialCapacity);
+			_recent.resize(std::max(0, _config.tabuShortTerm));
+		}
+
+		void insert(const std::shared_ptr<Step> &step)
+		{
+			const int expiry{_iteration + std::max(1, _random.between(_config.tabuLower, _config.tabuUpper))};
+			_remember(static_cast<std::size_t>(step->undoKey()), expiry);
+			if (!_recent.empty()) {
+				_recent[_recentNext] = Slot{_shortTermKey(*step), expiry, true};
+				_recentNext = (_recentNext + 1) % _recent.size();
+			}
+		}
+
+		void shift() noexcept //move to next iteration, which expires all elements that reached the end of their time
+		{
+			++_iteration;
+		}
+
+		void clear()
+		{
+			std::ranges::fill(_slots, Slot{});
+			std::ranges::fill(_recent, Slot{});
+			_used = 0;
+			_iteration = 0; //nothing is remembered, so the count can start over instead of overflowing in long chained runs
+		}
+
+		bool isTabu(const Step &step) const //return true if the given step is tabu according to the list
+		{
+			if (!_recent.empty()) {
+				const auto shortTermKey = _shortTermKey(step);
+				for (auto const &slot : _recent) {
+					if (slot.used && slot.key == shortTermKey && _isAlive(slot))
+						return true;
+				}
+			}
+			return _isAlive(_slots[_find(static_cast<std::size_t>(step.tabuKey()))]);
+		}
+
+	  private:
+
+		struct Config {
+			int tabuLower;
+			int tabuUpper;
+			int tabuShortTerm;
+		};
+
+		struct Slot {
+			std::size_t key{0};
+			int expiry{0}; //iteration from which the key is no longer tabu
+			bool used{false};
+		};
+
+		static constexpr std::size_t _initialCapacity{64}; //must be a power of two
+
+		void _configure(const boost::property_tree::ptree &pt)
+		{
+			_config.tabuLower = pt.get("tabuLower", 20);
+			_config.tabuUpper = pt.get("tabuUpper", 30);
+			_config.tabuShortTerm = pt.get("tabuShortTerm", 1);
+		}
+
+		static std::size_t _shortTermKey(const Step &step)
+		{
+			if constexpr (requires { step.shortTermKey(); })
+				return static_cast<std::size_t>(step.shortTermKey());
+			else
+				return static_cast<std::size_t>(step.tabuKey());
+		}
+
+		bool _isAlive(const Slot &slot) const noexcept
+		{
+			return slot.used && slot.expiry > _iteration;
+		}
+
+		//index of the slot holding the key, or of the unused slot ending its probe sequence
+		std::size_t _find(std::size_t key) const noexcept
+		{
+			const std::size_t mask{_slots.size() - 1};
+			auto i = _hash(key) & mask;
+			while (_slots[i].used && _slots[i].key != key)
+				i = (i + 1) & mask;
+
+			return i;
+		}
+
+		void _remember(std::size_t key, int expiry)
+		{
+			const std::size_t mask{_slots.size() - 1};
+			Slot *expired{nullptr}; //slot of an expired key that can be reused
+			auto i = _hash(key) & mask;
+			for (; _slots[i].used; i = (i + 1) & mask) {
+				if (_slots[i].key == key) {
+					_slots[i].expiry = std::max(_slots[i].expiry, expiry);
+					return;
+				}
+				if (!expired && !_isAlive(_slots[i]))
+					expired = &_slots[i];
+			}
+			if (expired) {
+				*expired = Slot{key, expiry, true};
+				return;
+			}
+			_slots[i] = Slot{key, expiry, true};
+			if (++_used * 4 > _slots.size() * 3)
+				_rehash();
+		}
+
+		//drop expired keys, growing the table if most of it is alive
+		void _rehash()
+		{
+			std::vector<Slot> alive;
+			std::ranges::copy_if(_slots, std::back_inserter(alive), [this](auto const &slot) { return _isAlive(slot); });
+
+			auto capacity = _initialCapacity;
+			while (capacity < alive.size() * 4)
+				capacity *= 2;
+
+			_slots.assign(capacity, Slot{});
+			_used = 0;
+			for (auto const &slot : alive) {
+				_slots[_find(slot.key)] = slot;
+				++_used;
+			}
+		}
+
+		static std::size_t _hash(std::size_t key) noexcept
+		{
+			//splitmix64 finalizer, so that sequential keys don't form long probe sequences
+			auto x = static_cast<std::uint64_t>(key);
+			x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+			return static_cast<std::size_t>(x ^ (x >> 31));
+		}
+
+		std::vector<Slot> _slots; //open-addressing table with linear probing
+		std::size_t _used{0}; //number of used slots, including expired ones
+		std::vector<Slot> _recent; //ring buffer of the most recent steps for short-term tabu
+		std::size_t _recentNext{0};
+		int _iteration{0};
+		Private::FastRandom &_random; //generates the random tabu tenures
+		Config _config;
+	};
+
+} //ns Algorithm::TabuSearch
+
+#endif //file guard
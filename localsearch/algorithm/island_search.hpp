@@ -0,0 +1,206 @@
+#ifndef _algorithm_island_search_included_
+#define _algorithm_island_search_included_
+
+#include "algorithm_group.hpp"
+#include "base.hpp"
+#include "config.hpp"
+#include "../events/async_dispatcher.hpp"
+#include "../factory.hpp"
+#include "../store.hpp"
+#include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Algorithm::Island {
+
+	//Island model parallel search.
+	//Runs the child algorithm (typically a chain) on several islands, each with its own copy of the solution and its own thread.
+	//Islands run the child algorithm in epochs. After each epoch, an island publishes its solution to a shared store if it's the best one so far,
+	//or adopts the best solution from the store if it's better than its own (migration).
+	//Optionally, islands are interrupted every migration interval, so that migration doesn't have to wait for long epochs to finish.
+	//The best solution migrated so far is published as a snapshot (see getBestSnapshot), which other threads can poll while the search runs.
+	//Note that the child algorithms fire their events from the island threads, with their copies of the solution.
+	template <class Solution>
+	class Searcher : public AlgorithmBase<Solution> {
+
+		using algorithm_ptr_t = typename Private::Factory<Solution>::algorithm_ptr_t;
+
+	  public:
+
+		explicit Searcher(const boost::property_tree::ptree &pt)
+		{
+			_config.load(pt);
+			_config.islands = pt.get("islands", 0);
+			if (_config.islands <= 0)
+				_config.islands = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+			_config.idleEpochs = pt.get("idleEpochs", 4);
+			_config.migrationInterval = std::chrono::milliseconds{pt.get("migrationInterval", 0)};
+
+			auto const &algNode = pt.get_child("algorithm");
+			_config.algorithm = std::pair{algNode.get<std::string>("name"), algNode.get_child("config")};
+			_config.propagate(_config.algorithm.second);
+		}
+
+		struct Config : Algorithm::Config {
+			int islands; //number of islands running in parallel (zero or less means one per hardware thread)
+			int idleEpochs; //island stops after this many epochs without improvement of its solution (interrupted epochs count too)
+			std::chrono::milliseconds migrationInterval; //how often are the islands interrupted to migrate (zero means only after their epochs end)
+			std::pair<std::string, boost::property_tree::ptree> algorithm; //child algorithm run on each island
+		};
+
+		const std::string &name() const noexcept final { return _name; }
+
+		void enableExtensions() noexcept final { _config.extended = true; }
+		void disableExtensions() noexcept final { _config.extended = false; }
+		const Config &getConfig() const noexcept { return _config; }
+
+		using snapshot_ptr_t = typename Storage::Store<Solution>::snapshot_ptr_t;
+
+		//best solution of the islands in the current (or last) run, null until the first island migrates
+		snapshot_ptr_t getBestSnapshot() const noexcept { return _bestSnapshot.load(); }
+
+	  private:
+
+		using store_t = Storage::Store<Solution>;
+
+		bool _run(Solution &solution) final
+		{
+			const Fitness starting{solution.getFitness()};
+			store_t store{std::make_shared<Solution>(solution)};
+			_bestSnapshot.store(nullptr);
+
+			Private::AlgorithmGroup group{*this};
+			std::vector<algorithm_ptr_t> algorithms;
+			for (int i = 0; i < _config.islands; ++i) {
+				auto config = _config.algorithm.second;
+				Config::propagateSeed(config, _config.seed, i); //each island has its own random streams
+				algorithms.push_back(SingleFactory<Solution>::Instance().createAlgorithm(_config.algorithm.first, config, &group));
+				if (_config.extended)
+					algorithms.back()->enableExtensions();
+			}
+
+			std::mutex mutex;
+			std::condition_variable finished;
+			int running{_config.islands};
+			std::exception_ptr error;
+
+			auto const populate = [&](IAlgorithmExec<Solution> &algorithm) {
+				try {
+					_populate(algorithm, store, group);
+				}
+				catch (...) {
+					std::lock_guard _{mutex};
+					if (!error)
+						error = std::current_exception();
+
+					group.stopAsync();
+				}
+				std::lock_guard _{mutex};
+				--running;
+				finished.notify_all();
+			};
+
+			std::vector<std::thread> threads;
+			for (auto const &alg : algorithms)
+				threads.emplace_back(populate, std::ref(*alg));
+
+			{
+				std::unique_lock lock{mutex};
+				if (_config.migrationInterval.count() > 0) {
+					//interrupt the epochs periodically so that the islands migrate
+					while (!finished.wait_for(lock, _config.migrationInterval, [&] { return running == 0; })) {
+						for (auto const &alg : algorithms)
+							alg->stopAsync();
+					}
+				}
+				else
+					finished.wait(lock, [&] { return running == 0; });
+			}
+			for (auto &thread : threads)
+				thread.join();
+
+			if (error)
+				std::rethrow_exception(error);
+
+			const auto locked = Storage::lockStore(store);
+			if (!(locked->getBestSolution()->getFitness() < starting))
+				return false;
+
+			solution = *locked->getBestSolution();
+			Algorithm::Events::publish<Solution>(Algorithm::Events::CurrentSolutionChanged { &solution, this->elapsedTime() });
+			Algorithm::Events::publish<Solution>(Algorithm::Events::BestSolutionFound { &solution, this->elapsedTime() });
+			return true;
+		}
+
+		//life of a single island, running on its own thread
+		void _populate(IAlgorithmExec<Solution> &algorithm, store_t &store, IAlgorithm &group) const
+		{
+			std::unique_ptr<Solution> solutionPtr;
+			{
+				const auto locked = Storage::lockStore(store);
+				solutionPtr = std::make_unique<Solution>(*locked->getBestSolution());
+			}
+			Fitness best{solutionPtr->getFitness()};
+			int idleEpochs{0};
+			while (!group.isStopRequested() && !best.isZero() && idleEpochs < _config.idleEpochs) {
+				algorithm.start(*solutionPtr);
+				_migrate(*solutionPtr, store);
+
+				const Fitness current{solutionPtr->getFitness()};
+				if (current < best) {
+					best = current;
+					idleEpochs = 0;
+				}
+				else
+					idleEpochs++;
+			}
+			if (best.isZero())
+				group.stopAsync(); //no other island can do better
+		}
+
+		//exchange solutions with the store, which holds the best solution of all islands
+		void _migrate(Solution &solution, store_t &store) const
+		{
+			const auto locked = Storage::lockStore(store);
+			const Fitness elite{locked->getBestSolution()->getFitness()};
+			if (solution.getFitness() < elite) {
+				*locked->getCurrentSolution() = solution;
+				locked->setBestSolution();
+				locked->publishBestSnapshot(); //the lock guards the current solution, which all islands write to
+				_bestSnapshot.store(locked->getBestSnapshot());
+			}
+			else if (elite < solution.getFitness())
+				solution = *locked->getBestSolution();
+		}
+
+		Config _config;
+		mutable std::atomic<snapshot_ptr_t> _bestSnapshot; //published by the islands, read by anyone
+		static const std::string _name;
+	};
+
+	template <class Solution>
+	const std::string Searcher<Solution>::_name{"Island search"};
+
+	//Registers the island search with the algorithm factory under the given name.
+	//Like Factory::registerAlgorithm, always returns true, so that it can be used to initialize a global registration variable.
+	template <class Solution>
+	bool registerSearcher(const std::string &name = "island")
+	{
+		return SingleFactory<Solution>::Instance().registerAlgorithm(name, [](const boost::property_tree::ptree &pt) {
+			return typename Private::Factory<Solution>::algorithm_ptr_t{std::make_unique<Searcher<Solution>>(pt)};
+		});
+	}
+
+} //ns Algorithm::Island
+
+#endif //file guard
@@ -0,0 +1,172 @@
+#ifndef _algorithm_late_acceptance_search_included_
+#define _algorithm_late_acceptance_search_included_
+
+#include "base.hpp"
+#include "best_tracker.hpp"
+#include "checkpoint.hpp"
+#include "config.hpp"
+#include "profiler.hpp"
+#include "random.hpp"
+#include "../events/async_dispatcher.hpp"
+#include "../fitness.hpp"
+#include "../events/audience.h"
+#include "../events/late_acceptance_search_events.h"
+#include "../interface/icheckpointed.h"
+#include "../interface/iprofiled.h"
+#include "../interface/isolution.h"
+#include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace Algorithm::LateAcceptance {
+
+	//Late Acceptance Hill Climbing, statically dispatched.
+	//Walks like the RNA search, but a step is also accepted if it's no worse than the fitness remembered from historyLength steps ago,
+	//which lets the search cross plateaus and small ridges while the history still remembers worse times.
+	//The history only remembers lower fitness than it had (as in Burke & Bykov, 2017), so it keeps tightening until the search converges.
+	//The search ends once the current solution goes without improvement for longer than both the history length and 2% of the steps taken so far.
+	//The derived class provides the search hooks, which are called directly, so that they can be inlined:
+	//	Fitness::delta_t _walk(Solution &, Fitness::delta_t maxDelta) const - proposes a random step,
+	//		executes it only if its delta doesn't exceed maxDelta and returns the delta of the executed step (zero if none)
+	//	bool _init(Solution &) - optional, prepares for walking and returns false if the algorithm can't run
+	//The hooks must be accessible to this class (public, or befriend it).
+	//The walk can draw its random numbers from _random(), which is cheaper than the shared engines.
+	template <class Derived, SearchSolution Solution>
+	class StaticSearcher : public AlgorithmBase<Solution>, public IProfiled, public ICheckpointed {
+
+	  public:
+
+		explicit StaticSearcher(const boost::property_tree::ptree &pt)
+		{
+			_config.load(pt);
+			_config.historyLength = std::max(1, pt.get("historyLength", 1000));
+			_config.tickFrequency = std::max(1, pt.get("tickFrequency", 1000));
+			_randomEngine.seed(_config.seed);
+			_profiler.enable(_config.profile);
+		}
+
+		struct Config : Algorithm::Config {
+			int historyLength; //how many steps back the fitness is remembered for acceptance
+			int tickFrequency; //how many steps between ticks
+		};
+
+		void enableExtensions() noexcept final { _config.extended = true; }
+		void disableExtensions() noexcept final { _config.extended = false; }
+		const Config &getConfig() const noexcept { return _config; }
+		Stats getStats() const noexcept final { return _profiler.stats(); }
+
+		//each run starts with a new history, only the random stream carries over
+		void saveState(Checkpoint::Writer &out) const final { out.write(_randomEngine.state()); }
+		void loadState(Checkpoint::Reader &in) final { _randomEngine.setState(in.read<std::array<std::uint64_t, 4>>()); }
+
+	  protected:
+
+		//default hook
+		bool _init(Solution &) { return true; }
+
+		Private::FastRandom &_random() const noexcept { return _randomEngine; }
+
+	  private:
+
+		bool _run(Solution &solution) noexcept(false) final
+		{
+			const Fitness startingFitness{solution.getFitness()};
+			Fitness bestFeasible{solution.isFeasible() ? startingFitness : Fitness::worst()}; //holds the fitness of the best feasible solution found so far
+			if (!_derived()._init(solution))
+				return false;
+
+			_best.reset(solution);
+			const int historyLength{_config.historyLength * (_config.extended ? 2 : 1)};
+			_history.assign(historyLength, startingFitness);
+			std::int64_t executedSteps{0};
+			std::int64_t noImprovements{0}; //steps since the current solution was last improved
+			std::size_t oldest{0}; //position in the history of the fitness from historyLength steps ago
+			while (!this->isStopRequested() && !solution.getFitness().isZero() && (noImprovements <= historyLength || noImprovements * 50 <= executedSteps)) {
+				noImprovements++;
+				executedSteps++;
+				const Fitness original{solution.getFitness()};
+				const Fitness::delta_t maxDelta{std::max(Fitness::delta_t{0}, _history[oldest] - original)};
+				Fitness::delta_t delta;
+				{
+					const Private::Profiler::Scope _{_profiler, Phase::neighborhood};
+					delta = _derived()._walk(solution, maxDelta);
+				}
+				const Fitness actual{Private::checkWalkFitness(solution, original, delta, _profiler, "Algorithm::LateAcceptance::StaticSearcher")};
+
+				if (delta > maxDelta)
+					throw std::logic_error("Algorithm::LateAcceptance::StaticSearcher::run: search step is worse than the late acceptance allows");
+
+				if (actual < _history[oldest])
+					_history[oldest] = actual; //only lowering the history makes its acceptance ever stricter, so the search converges
+				if (++oldest == _history.size())
+					oldest = 0;
+
+				if (delta < 0)
+					noImprovements = 0;
+
+				if (delta != 0 && Algorithm::Events::isHeard<Algorithm::Events::CurrentSolutionChanged>()) {
+					const Private::Profiler::Scope _{_profiler, Phase::events};
+					Algorithm::Events::publish<Solution>(Algorithm::Events::CurrentSolutionChanged { &solution, this->elapsedTime() });
+				}
+				if (actual < _best.fitness() && _best.isReplaceableBy(solution, _config.keepFeasible)) {
+					_best.update(solution);
+					const Private::Profiler::Scope _{_profiler, Phase::events};
+					Algorithm::Events::publish<Solution>(Algorithm::Events::BestSolutionFound { &solution, this->elapsedTime() });
+				}
+				if (solution.isFeasible() && actual < bestFeasible) {
+					bestFeasible = actual;
+					const Private::Profiler::Scope _{_profiler, Phase::events};
+					Algorithm::Events::publish<Solution>(Algorithm::Events::FeasibleSolutionFound { &solution, this->elapsedTime() });
+				}
+				if (executedSteps % _config.tickFrequency == 0) {
+					const Private::Profiler::Scope _{_profiler, Phase::events};
+					Algorithm::Events::publish<Solution>(Events::Tick{});
+				}
+			}
+
+			//end with the best solution found, preferring the current one if equal
+			if (solution.getFitness() > _best.fitness() || !_best.isReplaceableBy(solution, _config.keepFeasible)) {
+				_best.restore(solution);
+				Algorithm::Events::publish<Solution>(Algorithm::Events::CurrentSolutionChanged { &solution, this->elapsedTime() });
+			}
+			return solution.getFitness() < startingFitness;
+		}
+
+		Derived &_derived() noexcept { return static_cast<Derived &>(*this); }
+
+		Config _config;
+		mutable Private::FastRandom _randomEngine;
+		std::vector<Fitness> _history; //circular, fitness acceptable in each of the last historyLength steps
+		Private::Profiler _profiler;
+		Private::BestTracker<Solution> _best{_profiler};
+	};
+
+	//Late Acceptance Hill Climbing
+	//Dynamically dispatched, derive from it and override the hooks.
+	template <class Solution>
+	class Searcher : public StaticSearcher<Searcher<Solution>, Solution> {
+
+		friend StaticSearcher<Searcher<Solution>, Solution>;
+
+	  public:
+
+		using StaticSearcher<Searcher<Solution>, Solution>::StaticSearcher;
+
+	  private:
+
+		//Prepare for walking, if necessary.
+		//Return false if algorithm cannot run.
+		virtual bool _init(Solution &) { return true; }
+
+		//Propose a random step and execute it if its delta doesn't exceed maxDelta.
+		//Return the delta of the executed step, zero if none.
+		virtual Fitness::delta_t _walk(Solution &, Fitness::delta_t maxDelta) const = 0;
+	};
+
+} //ns Algorithm::LateAcceptance
+
+#endif //file guard
@@ -0,0 +1,72 @@
+#ifndef _algorithm_move_batch_included_
+#define _algorithm_move_batch_included_
+
+#include "../fitness.hpp"
+#include "../interface/isolution.h"
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace Algorithm::TabuSearch {
+
+	//Moves of (a part of) the neighborhood, evaluated together by the solution (see BatchEvaluation).
+	//The moves are compact descriptors (e.g. a pair of indices), their deltas are kept in separate contiguous arrays,
+	//so that the best ones can be found by a scan the compiler can vectorize, and steps only need to be created for them
+	//(see CandidateSet::offer).
+	//Reuse the batch (e.g. thread_local in the partition evaluation) to keep the evaluation free of allocations.
+	template <class Move>
+	class MoveBatch {
+
+	  public:
+
+		void clear() noexcept
+		{
+			_moves.clear();
+		}
+
+		void push_back(const Move &move)
+		{
+			_moves.push_back(move);
+		}
+
+		//lets the solution fill in the deltas of all moves
+		template <class Solution>
+			requires BatchEvaluation<Solution, Move>
+		void evaluate(const Solution &solution)
+		{
+			_deltas.resize(_moves.size());
+			_adaptedDeltas.resize(_moves.size());
+			solution.evaluate(std::span<const Move>{_moves}, std::span<Fitness::delta_t>{_deltas}, std::span<AdaptedFitness::delta_t>{_adaptedDeltas});
+		}
+
+		std::size_t size() const noexcept { return _moves.size(); }
+		bool empty() const noexcept { return _moves.empty(); }
+
+		const Move &move(std::size_t i) const noexcept { return _moves[i]; }
+		Fitness::delta_t delta(std::size_t i) const noexcept { return _deltas[i]; }
+		AdaptedFitness::delta_t adaptedDelta(std::size_t i) const noexcept { return _adaptedDeltas[i]; }
+
+		std::span<const Move> moves() const noexcept { return _moves; }
+		std::span<const Fitness::delta_t> deltas() const noexcept { return _deltas; }
+		std::span<const AdaptedFitness::delta_t> adaptedDeltas() const noexcept { return _adaptedDeltas; }
+
+		AdaptedFitness::delta_t minAdaptedDelta() const noexcept
+		{
+			auto best = AdaptedFitness::worstDelta();
+			for (auto adaptedDelta : _adaptedDeltas)
+				best = std::min(best, adaptedDelta);
+
+			return best;
+		}
+
+	  private:
+
+		std::vector<Move> _moves;
+		std::vector<Fitness::delta_t> _deltas;
+		std::vector<AdaptedFitness::delta_t> _adaptedDeltas;
+	};
+
+} //ns Algorithm::TabuSearch
+
+#endif //file guard
@@ -0,0 +1,141 @@
+#ifndef _algorithm_move_cache_included_
+#define _algorithm_move_cache_included_
+
+#include "candidate_set.hpp"
+#include "../fitness.hpp"
+#include <compare>
+#include <functional>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace Algorithm::TabuSearch {
+
+	//Cached evaluation of a neighborhood split into regions (the partitions of the tabu search).
+	//Keeps all steps of each region ranked by their adapted delta, so that only the regions touched by the executed step
+	//need to be evaluated again, instead of the whole neighborhood.
+	//The steps of a region must stay valid (including their deltas) as long as the region isn't touched.
+	//The regions are candidate sets of the searcher's type (see CandidateSet), which keep all steps offered.
+	template <class Step, class Acceptance = std::function<bool(const Step &, Fitness)>>
+	class MoveCache {
+
+	  public:
+
+		using step_ptr_t = std::shared_ptr<Step>;
+		using candidates_t = CandidateSet<Step, Acceptance>;
+
+		//sets the number of regions, evaluating all of them again if it changed
+		void resize(int count)
+		{
+			if (count == static_cast<int>(_regions.size()))
+				return;
+
+			_regions.assign(count, candidates_t{});
+			_ranked.assign(count, {});
+			_isDirty.assign(count, false);
+			_dirty.clear();
+			invalidateAll();
+		}
+
+		void invalidate(int region)
+		{
+			if (_allDirty || region < 0 || region >= static_cast<int>(_regions.size()) || _isDirty[region])
+				return;
+
+			_isDirty[region] = true;
+			_dirty.push_back(region);
+		}
+
+		//e.g. when the solution was replaced, or the evaluation of the steps changed
+		void invalidateAll() noexcept
+		{
+			_allDirty = true;
+		}
+
+		//Prepares the invalidated regions for evaluation and returns them.
+		//Their candidate sets are to be filled by offering all steps of the region, then call commit().
+		const std::vector<int> &beginUpdate(Fitness currentFitness)
+		{
+			if (_allDirty) {
+				_ranking.clear();
+				_dirty.clear();
+				for (int region = 0; region < static_cast<int>(_regions.size()); ++region) {
+					_regions[region].reset(currentFitness);
+					_ranked[region].clear();
+					_isDirty[region] = true;
+					_dirty.push_back(region);
+				}
+				_allDirty = false;
+				return _dirty;
+			}
+			for (int region : _dirty) {
+				auto &ranked = _ranked[region];
+				for (int i = 0; i < static_cast<int>(ranked.size()); ++i)
+					_ranking.erase(Entry{ranked[i], region, i});
+
+				ranked.clear();
+				_regions[region].reset(currentFitness);
+			}
+			return _dirty;
+		}
+
+		candidates_t &region(int region) noexcept { return _regions[region]; }
+
+		//ranks the steps of the evaluated regions
+		void commit()
+		{
+			for (int region : _dirty) {
+				auto const &steps = _regions[region].steps();
+				auto &ranked = _ranked[region];
+				ranked.clear();
+				for (int i = 0; i < static_cast<int>(steps.size()); ++i) {
+					ranked.push_back(steps[i]->adaptedDelta());
+					_ranking.insert(Entry{ranked.back(), region, i});
+				}
+				_isDirty[region] = false;
+			}
+			_dirty.clear();
+		}
+
+		//Returns all acceptable steps sharing the best adapted delta, in the order of their regions.
+		//Only the steps ranked up to the first acceptable ones are checked.
+		template <class IsAcceptable>
+		std::vector<step_ptr_t> bestSteps(Fitness currentFitness, IsAcceptable &&isAcceptable) const
+		{
+			std::vector<step_ptr_t> steps;
+			auto bestDelta = AdaptedFitness::worstDelta();
+			for (auto const &entry : _ranking) {
+				if (entry.adaptedDelta > bestDelta)
+					break;
+
+				auto const &step = _regions[entry.region].steps()[entry.index];
+				if (isAcceptable(*step, currentFitness)) {
+					steps.push_back(step);
+					bestDelta = entry.adaptedDelta;
+				}
+			}
+			return steps;
+		}
+
+	  private:
+
+		struct Entry {
+
+			auto operator<=>(const Entry &) const = default;
+
+			AdaptedFitness::delta_t adaptedDelta;
+			int region;
+			int index; //of the step in its region
+		};
+
+		std::vector<candidates_t> _regions; //all steps of each region, as last evaluated
+		std::set<Entry> _ranking; //all cached steps, best first
+		std::vector<std::vector<AdaptedFitness::delta_t>> _ranked; //adapted deltas of the steps of each region as ranked, to find their entries even if the deltas changed since
+		std::vector<bool> _isDirty;
+		std::vector<int> _dirty; //regions to evaluate again
+		bool _allDirty{true};
+	};
+
+} //ns Algorithm::TabuSearch
+
+#endif //file guard
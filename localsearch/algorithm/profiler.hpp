@@ -0,0 +1,106 @@
+#ifndef _algorithm_profiler_included_
+#define _algorithm_profiler_included_
+
+#include "../interface/iprofiled.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Algorithm::Private {
+
+	//Accumulates time and counts of the search phases, if enabled at runtime (see Config::profile).
+	//Can be used from multiple threads, e.g. by neighborhood partitions evaluated in parallel.
+	//Define LOCALSEARCH_NO_PROFILING to remove the instrumentation at compile time.
+	class Profiler {
+
+	  public:
+
+		using clock_t = std::chrono::steady_clock;
+
+		//measures the time spent in a scope as one entry of the phase
+		class Scope {
+
+		  public:
+
+#ifdef LOCALSEARCH_NO_PROFILING
+			Scope(const Profiler &, Phase) noexcept {}
+#else
+			Scope(const Profiler &profiler, Phase phase) noexcept
+			:
+				_profiler{profiler.isEnabled() ? &profiler : nullptr},
+				_phase{phase}
+			{
+				if (_profiler)
+					_started = clock_t::now();
+			}
+
+			~Scope()
+			{
+				if (_profiler)
+					_profiler->add(_phase, clock_t::now() - _started);
+			}
+#endif
+
+			Scope(const Scope &) = delete;
+			Scope &operator=(const Scope &) = delete;
+
+#ifndef LOCALSEARCH_NO_PROFILING
+		  private:
+
+			const Profiler *_profiler;
+			Phase _phase;
+			clock_t::time_point _started;
+#endif
+		};
+
+#ifdef LOCALSEARCH_NO_PROFILING
+		void enable(bool) noexcept {}
+		static constexpr bool isEnabled() noexcept { return false; }
+		void add(Phase, clock_t::duration) const noexcept {}
+		void count(Phase) const noexcept {}
+		Stats stats() const noexcept { return {}; }
+#else
+		void enable(bool enabled) noexcept { _enabled = enabled; }
+		bool isEnabled() const noexcept { return _enabled; }
+
+		void add(Phase phase, clock_t::duration time) const noexcept
+		{
+			auto &counter = _counters[static_cast<std::size_t>(phase)];
+			counter.count.fetch_add(1, std::memory_order_relaxed);
+			counter.time.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count(), std::memory_order_relaxed);
+		}
+
+		//for phases without time measurement
+		void count(Phase phase) const noexcept
+		{
+			if (_enabled)
+				_counters[static_cast<std::size_t>(phase)].count.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		Stats stats() const noexcept
+		{
+			Stats stats;
+			for (std::size_t i = 0; i < _counters.size(); ++i) {
+				stats.phases[i].count = _counters[i].count.load(std::memory_order_relaxed);
+				stats.phases[i].time = std::chrono::nanoseconds{_counters[i].time.load(std::memory_order_relaxed)};
+			}
+			return stats;
+		}
+
+	  private:
+
+		struct Counter {
+			std::atomic<std::int64_t> count{0};
+			std::atomic<std::int64_t> time{0}; //nanoseconds
+		};
+
+		bool _enabled{false};
+		mutable std::array<Counter, static_cast<std::size_t>(Phase::count)> _counters;
+#endif
+	};
+
+} //ns Algorithm::Private
+
+#endif //file guard
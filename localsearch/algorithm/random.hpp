@@ -0,0 +1,96 @@
+#ifndef _algorithm_random_included_
+#define _algorithm_random_included_
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace Algorithm::Private {
+
+	//Seed of an independent random stream, derived deterministically from the parent seed and the stream number.
+	//Used to give each child algorithm (or repeat, island, etc.) its own reproducible stream.
+	constexpr std::uint64_t deriveSeed(std::uint64_t seed, std::uint64_t stream) noexcept
+	{
+		std::uint64_t z{seed ^ (stream + 1) * 0x9e3779b97f4a7c15};
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+		return z ^ (z >> 31);
+	}
+
+	//Small and fast random engine (xoshiro256**) for the hot paths of the searchers.
+	//Each searcher owns its instance, seeded from Config::seed, so there's no sharing between threads and no locking.
+	//Satisfies std::uniform_random_bit_generator, so it can be used with the standard distributions.
+	class FastRandom {
+
+	  public:
+
+		using result_type = std::uint64_t;
+
+		explicit FastRandom(std::uint64_t seed = 0) noexcept
+		{
+			this->seed(seed);
+		}
+
+		void seed(std::uint64_t seed) noexcept
+		{
+			//expand the seed by splitmix64, which never yields the all-zero state
+			for (auto &s : _state) {
+				seed += 0x9e3779b97f4a7c15;
+				std::uint64_t z{seed};
+				z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+				z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+				s = z ^ (z >> 31);
+			}
+		}
+
+		//for checkpoints, the engine continues the same stream after setting the state it had
+		std::array<result_type, 4> state() const noexcept { return _state; }
+		void setState(const std::array<result_type, 4> &state) noexcept { _state = state; }
+
+		static constexpr result_type min() noexcept { return 0; }
+		static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+		result_type operator()() noexcept
+		{
+			const result_type result{_rotl(_state[1] * 5, 7) * 9};
+			const result_type t{_state[1] << 17};
+			_state[2] ^= _state[0];
+			_state[3] ^= _state[1];
+			_state[1] ^= _state[2];
+			_state[0] ^= _state[3];
+			_state[2] ^= t;
+			_state[3] = _rotl(_state[3], 45);
+			return result;
+		}
+
+		//uniform integer in [0, bound), without the overhead of std::uniform_int_distribution (bias is negligible for small bounds)
+		std::uint32_t below(std::uint32_t bound) noexcept
+		{
+			return static_cast<std::uint32_t>(((*this)() >> 32) * bound >> 32);
+		}
+
+		//uniform integer in [lower, upper]
+		int between(int lower, int upper) noexcept
+		{
+			return lower + static_cast<int>(below(static_cast<std::uint32_t>(upper - lower) + 1));
+		}
+
+		//uniform real in [0, 1)
+		double unit() noexcept
+		{
+			return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+		}
+
+	  private:
+
+		static constexpr result_type _rotl(result_type x, int k) noexcept
+		{
+			return (x << k) | (x >> (64 - k));
+		}
+
+		std::array<result_type, 4> _state;
+	};
+
+} //ns Algorithm::Private
+
+#endif //file guard
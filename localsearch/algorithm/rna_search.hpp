@@ -2,44 +2,139 @@
 #define _algorithm_rna_search_included_
 
 #include "base.hpp"
+#include "best_tracker.hpp"
+#include "checkpoint.hpp"
 #include "config.hpp"
+#include "profiler.hpp"
+#include "random.hpp"
+#include "worker_pool.hpp"
+#include "../events/async_dispatcher.hpp"
 #include "../fitness.hpp"
+#include "../events/audience.h"
 #include "../events/rna_search_events.h"
+#include "../interface/icheckpointed.h"
+#include "../interface/iprofiled.h"
+#include "../interface/isolution.h"
 #include <boost/property_tree/ptree.hpp>
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace Algorithm::RNA {
 
-	//Random Non-Ascendent search algorithm
-	template <class Solution>
-	class Searcher : public AlgorithmBase<Solution> {
+	//Random Non-Ascendent search algorithm, statically dispatched.
+	//The derived class provides the search hooks, which are called directly, so that they can be inlined:
+	//	Fitness::delta_t _walk(Solution &) const - takes a random non-ascending step and returns its delta
+	//	bool _init(Solution &) - optional, prepares for walking and returns false if the algorithm can't run
+	//The hooks must be accessible to this class (public, or befriend it).
+	//The walk can draw its random numbers from _random(), which is cheaper than the shared engines.
+	//Instead of walking, the derived class can propose steps, which the searcher evaluates in batches (in parallel if enabled) and applies the chosen one.
+	//It then declares the type Proposal (default constructible) describing a step, and provides instead of _walk:
+	//	Fitness::delta_t _propose(const Solution &, Private::FastRandom &, Proposal &) const - draws a random step from the engine,
+	//		describes it in the proposal and returns its delta, without changing the solution
+	//	void _apply(Solution &, const Proposal &) const - executes the proposed step
+	//Proposals are evaluated concurrently, so they must only read the solution.
+	//Each proposal of a batch has its own random stream, so the chosen steps don't depend on the number of threads.
+	//Every batch is a round-trip to the worker threads, so more threads only pay off when proposing a step is expensive
+	//compared to the synchronization; cheap proposals (like recoloring a vertex) run faster on a single thread.
+	template <class Derived, SearchSolution Solution>
+	class StaticSearcher : public AlgorithmBase<Solution>, public IProfiled, public ICheckpointed {
 
 	  public:
 
-		explicit Searcher(const boost::property_tree::ptree &pt)
+		explicit StaticSearcher(const boost::property_tree::ptree &pt)
 		{
 			_config.load(pt);
 			_config.maxSteps = pt.get("maxSteps", 1000);
 			_config.tickFrequency = std::max(1, pt.get("tickFrequency", 1000));
+			_config.proposals = std::max(1, pt.get("proposals", 1));
+			_config.threads = pt.get("threads", 1);
+			_config.proposalChoice = _parseProposalChoice(pt.get<std::string>("proposalChoice", "best"));
+			_randomEngine.seed(_config.seed);
+			_profiler.enable(_config.profile);
+
+			if (_proposes()) {
+				for (int i = 0; i < _config.proposals; ++i)
+					_proposalRandom.emplace_back(Private::deriveSeed(_config.seed, i));
+
+				if (_config.threads != 1 && _config.proposals > 1)
+					_workers = std::make_unique<Private::WorkerPool>(_config.threads);
+			}
+			else if (_config.proposals > 1)
+				throw std::runtime_error("Algorithm::RNA::StaticSearcher: batches of proposals require the searcher to propose steps");
 		}
 
+		//which of the non-ascending proposals of a batch is applied, the earliest one on ties
+		enum class ProposalChoice {
+			best, //the one with the lowest delta
+			first //the first improving one, or the first neutral one if none improves
+		};
+
 		struct Config : Algorithm::Config {
-			int maxSteps;
+			int maxSteps; //proposals without improvement that end the search
 			int tickFrequency; //how many steps between ticks
+			int proposals; //how many proposals are evaluated in a batch (if the searcher proposes steps)
+			int threads; //how many threads evaluate the proposals (zero or less means all hardware threads), only for expensive proposals
+			ProposalChoice proposalChoice; //"best" or "first"
 		};
 
 		void enableExtensions() noexcept final { _config.extended = true; }
 		void disableExtensions() noexcept final { _config.extended = false; }
 		const Config &getConfig() const noexcept { return _config; }
+		Stats getStats() const noexcept final { return _profiler.stats(); }
+
+		//the random streams are the only state carried over between runs
+		void saveState(Checkpoint::Writer &out) const final
+		{
+			out.write(_randomEngine.state());
+			for (auto const &random : _proposalRandom)
+				out.write(random.state());
+		}
+
+		void loadState(Checkpoint::Reader &in) final
+		{
+			_randomEngine.setState(in.read<std::array<std::uint64_t, 4>>());
+			for (auto &random : _proposalRandom)
+				random.setState(in.read<std::array<std::uint64_t, 4>>());
+		}
+
+	  protected:
+
+		//default hook
+		bool _init(Solution &) { return true; }
+
+		Private::FastRandom &_random() const noexcept { return _randomEngine; }
 
 	  private:
 
 		bool _run(Solution &solution) noexcept(false) final
+		{
+			if constexpr (_proposes()) {
+				std::vector<typename Derived::Proposal> proposals(_proposalRandom.size());
+				std::vector<Fitness::delta_t> deltas(_proposalRandom.size());
+				return _search(solution, static_cast<int>(proposals.size()), [&](Solution &current) {
+					return _walkBatch(current, proposals, deltas);
+				});
+			}
+			else {
+				return _search(solution, 1, [this](Solution &current) {
+					return _derived()._walk(current);
+				});
+			}
+		}
+
+		//Runs the search, each walk taking a step out of the given number of random ones.
+		//The steps are counted by the random ones, so that maxSteps and ticks mean the same in both modes.
+		template <class Walk>
+		bool _search(Solution &solution, int stepsPerWalk, Walk &&walk)
 		{
 			const Fitness startingFitness{solution.getFitness()};
 			Fitness bestFeasible{solution.isFeasible() ? startingFitness : Fitness::worst()}; //holds the fitness of the best feasible solution found so far
-			if (!_init(solution))
+			if (!_derived()._init(solution))
 				return false;
 
 			const int maxSteps{_config.maxSteps * (_config.extended ? 2 : 1)};
@@ -47,41 +142,116 @@ namespace Algorithm::RNA {
 			int executedSteps{0};
 			int noImprovements{0};
 			while (!this->isStopRequested() && !solution.getFitness().isZero() && (noImprovements < maxSteps)) {
-				noImprovements++;
-				executedSteps++;
+				noImprovements += stepsPerWalk;
+				executedSteps += stepsPerWalk;
 				const Fitness original{solution.getFitness()};
-				auto const delta = _walk(solution);
-				const Fitness actual{solution.getFitness()};
-				if (actual != original + delta)
-					throw std::logic_error("Algorithm::RNA::Searcher::run: unexpected fitness delta after walk. Expected " + std::to_string(delta) + ", got " + std::to_string(actual - original));
+				Fitness::delta_t delta;
+				{
+					const Private::Profiler::Scope _{_profiler, Phase::neighborhood};
+					delta = walk(solution);
+				}
+				const Fitness actual{Private::checkWalkFitness(solution, original, delta, _profiler, "Algorithm::RNA::StaticSearcher")};
 
 				if (delta > 0)
-					throw std::logic_error("Algorithm::RNA::Searcher::run: search step has positive delta");
+					throw std::logic_error("Algorithm::RNA::StaticSearcher::run: search step has positive delta");
 
 				if (delta < 0) {
 					noImprovements = 0;
 					improved = true;
-					Ctoolhu::Event::Fire(Algorithm::Events::CurrentSolutionChanged { &solution, this->elapsedTime() });
-					Ctoolhu::Event::Fire(Algorithm::Events::BestSolutionFound { &solution, this->elapsedTime() });
+					const Private::Profiler::Scope _{_profiler, Phase::events};
+					if (Algorithm::Events::isHeard<Algorithm::Events::CurrentSolutionChanged>())
+						Algorithm::Events::publish<Solution>(Algorithm::Events::CurrentSolutionChanged { &solution, this->elapsedTime() });
+
+					Algorithm::Events::publish<Solution>(Algorithm::Events::BestSolutionFound { &solution, this->elapsedTime() });
 				}
 				if (solution.isFeasible() && actual < bestFeasible) {
 					bestFeasible = actual;
-					Ctoolhu::Event::Fire(Algorithm::Events::FeasibleSolutionFound { &solution, this->elapsedTime() });
+					const Private::Profiler::Scope _{_profiler, Phase::events};
+					Algorithm::Events::publish<Solution>(Algorithm::Events::FeasibleSolutionFound { &solution, this->elapsedTime() });
+				}
+				if (executedSteps / _config.tickFrequency != (executedSteps - stepsPerWalk) / _config.tickFrequency) {
+					const Private::Profiler::Scope _{_profiler, Phase::events};
+					Algorithm::Events::publish<Solution>(Events::Tick{});
 				}
-				if (executedSteps % _config.tickFrequency == 0)
-					Ctoolhu::Event::Fire<Events::Tick>();
 			}
 			assert(solution.getFitness() <= startingFitness && "RNA search should not worsen the solution");
 			return improved;
 		}
 
+		//Evaluates a batch of proposals on the current solution and applies the chosen one, if any is non-ascending.
+		//Returns the delta of the applied step (zero if none).
+		template <class Proposal>
+		Fitness::delta_t _walkBatch(Solution &solution, std::vector<Proposal> &proposals, std::vector<Fitness::delta_t> &deltas)
+		{
+			const Solution &current{solution};
+			auto const propose = [this, &current, &proposals, &deltas](int i) {
+				deltas[i] = _derived()._propose(current, _proposalRandom[i], proposals[i]);
+			};
+			if (_workers)
+				_workers->run(static_cast<int>(proposals.size()), propose);
+			else {
+				for (int i = 0; i < static_cast<int>(proposals.size()); ++i)
+					propose(i);
+			}
+
+			int chosen{-1};
+			for (int i = 0; i < static_cast<int>(deltas.size()); ++i) {
+				if (deltas[i] > 0)
+					continue;
+
+				if (chosen < 0 || (deltas[i] < deltas[chosen] && (_config.proposalChoice == ProposalChoice::best || deltas[chosen] == 0)))
+					chosen = i;
+			}
+			if (chosen < 0)
+				return 0;
+
+			_derived()._apply(solution, proposals[chosen]);
+			return deltas[chosen];
+		}
+
+		//whether the derived class proposes steps instead of walking
+		static constexpr bool _proposes() noexcept
+		{
+			return requires { typename Derived::Proposal; };
+		}
+
+		static ProposalChoice _parseProposalChoice(const std::string &name)
+		{
+			if (name == "best")
+				return ProposalChoice::best;
+			if (name == "first")
+				return ProposalChoice::first;
+
+			throw std::runtime_error("Algorithm::RNA::StaticSearcher: unknown proposal choice '" + name + "'");
+		}
+
+		Derived &_derived() noexcept { return static_cast<Derived &>(*this); }
+
+		Config _config;
+		mutable Private::FastRandom _randomEngine;
+		std::vector<Private::FastRandom> _proposalRandom; //stream of each proposal of a batch, in the batched mode
+		std::unique_ptr<Private::WorkerPool> _workers; //parallel evaluation of the proposals, null if single-threaded
+		Private::Profiler _profiler;
+	};
+
+	//Random Non-Ascendent search algorithm
+	//Dynamically dispatched, derive from it and override the hooks.
+	template <class Solution>
+	class Searcher : public StaticSearcher<Searcher<Solution>, Solution> {
+
+		friend StaticSearcher<Searcher<Solution>, Solution>;
+
+	  public:
+
+		using StaticSearcher<Searcher<Solution>, Solution>::StaticSearcher;
+
+	  private:
+
 		//Prepare for walking, if necessary.
 		//Return false if algorithm cannot run.
 		virtual bool _init(Solution &) { return true; }
 
 		virtual Fitness::delta_t _walk(Solution &) const = 0;
-
-		Config _config;
 	};
 
 } //ns Algorithm::RNA
@@ -0,0 +1,186 @@
+#ifndef _algorithm_segmented_array_included_
+#define _algorithm_segmented_array_included_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Algorithm {
+
+	//Array split into fixed-size segments, which are shared between copies of the array and copied only when written to (copy-on-write).
+	//Meant as the storage of large solutions: the searchers and the stores keep copies of the solution (the best one, the feasible one, etc.),
+	//which then cost only the segments changed since, both in time and memory.
+	//Assigning an array that shares segments with this one only touches the differing segments.
+	//Reading is through operator[], writing through mutate() or set(), which make the segment private first.
+	//Copies can be used by different threads, as long as each array object is used by one thread at a time.
+	template <class T, std::size_t SegmentSize = 256>
+	class SegmentedArray {
+
+		static_assert(std::has_single_bit(SegmentSize), "Algorithm::SegmentedArray: segment size must be a power of two");
+
+		using segment_t = std::array<T, SegmentSize>;
+		using segment_ptr_t = std::shared_ptr<segment_t>;
+
+	  public:
+
+		using value_type = T;
+
+		class const_iterator {
+
+		  public:
+
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const T *;
+			using reference = const T &;
+
+			const_iterator() = default;
+			const_iterator(const SegmentedArray *array, std::size_t index) noexcept : _array{array}, _index{index} {}
+
+			reference operator*() const noexcept { return (*_array)[_index]; }
+			pointer operator->() const noexcept { return &(*_array)[_index]; }
+			const_iterator &operator++() noexcept { ++_index; return *this; }
+			const_iterator operator++(int) noexcept { auto copy{*this}; ++_index; return copy; }
+			bool operator==(const const_iterator &other) const noexcept { return _index == other._index; }
+
+		  private:
+
+			const SegmentedArray *_array{nullptr};
+			std::size_t _index{0};
+		};
+
+		SegmentedArray() = default;
+
+		explicit SegmentedArray(std::size_t size, const T &value = T{})
+		{
+			assign(size, value);
+		}
+
+		SegmentedArray(const SegmentedArray &) = default;
+
+		//the moved-from array is left empty
+		SegmentedArray(SegmentedArray &&other) noexcept
+		:
+			_segments{std::move(other._segments)},
+			_size{std::exchange(other._size, 0)}
+		{
+			other._segments.clear();
+		}
+
+		SegmentedArray &operator=(SegmentedArray &&other) noexcept
+		{
+			if (this == &other)
+				return *this;
+
+			_segments = std::move(other._segments);
+			_size = std::exchange(other._size, 0);
+			other._segments.clear();
+			return *this;
+		}
+
+		SegmentedArray &operator=(const SegmentedArray &other)
+		{
+			if (this == &other)
+				return *this;
+
+			_segments.resize(other._segments.size());
+			for (std::size_t i = 0; i < _segments.size(); ++i) {
+				if (_segments[i] != other._segments[i])
+					_segments[i] = other._segments[i];
+			}
+			_size = other._size;
+			return *this;
+		}
+
+		//replaces the contents with new segments, shared with no other array
+		void assign(std::size_t size, const T &value)
+		{
+			_size = size;
+			_segments.clear();
+			_segments.reserve((size + SegmentSize - 1) / SegmentSize);
+			while (_segments.size() * SegmentSize < size) {
+				auto segment = std::make_shared<segment_t>();
+				segment->fill(value);
+				_segments.push_back(std::move(segment));
+			}
+		}
+
+		void fill(const T &value)
+		{
+			assign(_size, value);
+		}
+
+		std::size_t size() const noexcept { return _size; }
+		bool empty() const noexcept { return _size == 0; }
+
+		const T &operator[](std::size_t index) const noexcept
+		{
+			return (*_segments[index / SegmentSize])[index % SegmentSize];
+		}
+
+		//writable element, its segment is copied first if it's shared with another array
+		T &mutate(std::size_t index)
+		{
+			return _own(index / SegmentSize)[index % SegmentSize];
+		}
+
+		void set(std::size_t index, const T &value)
+		{
+			mutate(index) = value;
+		}
+
+		const_iterator begin() const noexcept { return {this, 0}; }
+		const_iterator end() const noexcept { return {this, _size}; }
+
+		//shared segments are equal without comparing their elements
+		bool operator==(const SegmentedArray &other) const
+		{
+			if (_size != other._size)
+				return false;
+
+			for (std::size_t i = 0; i < _segments.size(); ++i) {
+				if (_segments[i] == other._segments[i])
+					continue;
+
+				const std::size_t used{std::min(SegmentSize, _size - i * SegmentSize)};
+				if (!std::equal(_segments[i]->begin(), _segments[i]->begin() + used, other._segments[i]->begin()))
+					return false;
+			}
+			return true;
+		}
+
+		//number of segments not shared with any other array, i.e. the memory the array would free if destroyed
+		std::size_t ownedSegments() const noexcept
+		{
+			return static_cast<std::size_t>(std::ranges::count_if(_segments, [](const segment_ptr_t &segment) { return segment.use_count() == 1; }));
+		}
+
+		static constexpr std::size_t segmentSize() noexcept { return SegmentSize; }
+
+	  private:
+
+		segment_t &_own(std::size_t index)
+		{
+			auto &segment = _segments[index];
+			if (segment.use_count() != 1)
+				segment = std::make_shared<segment_t>(*segment);
+			else
+				std::atomic_thread_fence(std::memory_order_acquire); //the last reads through a copy released by another thread happen before the write
+
+			return *segment;
+		}
+
+		std::vector<segment_ptr_t> _segments;
+		std::size_t _size{0};
+	};
+
+} //ns Algorithm
+
+#endif //file guard
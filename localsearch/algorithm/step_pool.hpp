@@ -0,0 +1,47 @@
+#ifndef _algorithm_step_pool_included_
+#define _algorithm_step_pool_included_
+
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+namespace Algorithm::TabuSearch {
+
+	//Recycles memory of steps, so that generating candidates doesn't hit the global allocator in the steady state.
+	//Memory of a step (including its shared pointer control block) returns to the pool when the last pointer to it is released.
+	//That means candidates which weren't chosen are recycled right after the iteration,
+	//while executed steps keep their memory for as long as they're referenced by the tabu list.
+	//Steps made by the pool must not outlive it.
+	template <class Step>
+	class StepPool {
+
+	  public:
+
+		//concurrent pool must be used if steps are made or released from multiple threads at the same time
+		explicit StepPool(bool concurrent)
+		{
+			if (concurrent)
+				_resource = std::make_unique<std::pmr::synchronized_pool_resource>();
+			else
+				_resource = std::make_unique<std::pmr::unsynchronized_pool_resource>();
+		}
+
+		template <class ConcreteStep = Step, class... Args>
+		std::shared_ptr<ConcreteStep> make(Args &&...args) const
+		{
+			static_assert(std::is_base_of_v<Step, ConcreteStep>, "Algorithm::TabuSearch::StepPool::make: step type mismatch");
+			return std::allocate_shared<ConcreteStep>(
+				std::pmr::polymorphic_allocator<ConcreteStep>{_resource.get()},
+				std::forward<Args>(args)...
+			);
+		}
+
+	  private:
+
+		std::unique_ptr<std::pmr::memory_resource> _resource;
+	};
+
+} //ns Algorithm::TabuSearch
+
+#endif //file guard
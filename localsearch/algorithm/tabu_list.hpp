@@ -1,30 +1,33 @@
 #ifndef _algorithm_tabu_list_included
 #define _algorithm_tabu_list_included
 
+#include "random.hpp"
 #include "tabu_element.hpp"
 #include <ctoolhu/std_ext.hpp>
-#include <ctoolhu/random/generator.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <vector>
 
 namespace Algorithm::TabuSearch {
 
-	//list of steps that are tabu to perform (with exception of aspiration steps)
+	//List of steps that are tabu to perform (with exception of aspiration steps).
+	//This is the default tabu list policy of the tabu search, alternative policies must provide the same public interface.
+	//Step must provide isUndoOf(const Step &) and isEqualForShortTermTabu(const Step &).
+	//The tabu tenures are drawn from the random engine of the searcher, which must outlive the list.
 	template <class Step>
 	class TabuList {
 
 	  public:
 
-		explicit TabuList(const boost::property_tree::ptree &pt)
+		TabuList(const boost::property_tree::ptree &pt, Private::FastRandom &random)
 		:
-			_tabuGenerator(pt.get("tabuLower", 20), pt.get("tabuUpper", 30))
+			_random{random}
 		{
 			_configure(pt);
 		}
 
 		void insert(const std::shared_ptr<Step> &step)
 		{
-			_elements.emplace_back(_tabuGenerator(), step);
+			_elements.emplace_back(_random.between(_config.tabuLower, _config.tabuUpper), step);
 		}
 
 		void shift() //decrease tabu counter and remove all elements that reached the end of their time
@@ -70,7 +73,7 @@ namespace Algorithm::TabuSearch {
 		}
 
 		std::vector<TabuElement<Step>> _elements;
-		Ctoolhu::Random::SmallIntGenerator _tabuGenerator; //random tabu iterations number generator
+		Private::FastRandom &_random; //generates the random tabu tenures
 		Config _config;
 	};
 
@@ -2,32 +2,81 @@
 #define _algorithm_tabu_search_included_
 
 #include "base.hpp"
+#include "checkpoint.hpp"
+#include "candidate_set.hpp"
 #include "config.hpp"
+#include "move_cache.hpp"
+#include "profiler.hpp"
+#include "random.hpp"
+#include "step_pool.hpp"
 #include "tabu_list.hpp"
+#include "visited_set.hpp"
+#include "worker_pool.hpp"
+#include "../events/async_dispatcher.hpp"
+#include "../events/audience.h"
 #include "../events/tabu_search_events.h"
 #include "../events/events.h"
+#include "../interface/icheckpointed.h"
+#include "../interface/iprofiled.h"
 #include "../interface/isolution.h"
 #include "../interface/istep.h"
 #include <ctoolhu/event/firer.hpp>
-#include <ctoolhu/random/selector.hpp>
 #include <boost/property_tree/ptree.hpp>
-#include <sstream>
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <numeric>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Algorithm::TabuSearch {
 
-	template <class Solution, class Step, class Enable = void>
-	class Searcher;
-
-	//Tabu search algorithm
-	template <class Solution, class Step>
-	class Searcher<Solution, Step, typename std::enable_if<std::is_base_of<IStep<Solution>, Step>::value>::type> : public AlgorithmBase<Solution> {
+	//Tabu search algorithm, statically dispatched.
+	//The derived class provides the search hooks, which are called directly, so that they can be inlined.
+	//All hooks are optional, but either _getBestSteps or the partition hooks must be provided (the search throws otherwise):
+	//	bool _init(Solution &) - prepares for getting best steps and returns false if the algorithm can't run
+	//	std::vector<std::shared_ptr<Step>> _getBestSteps(Solution &) const - returns continuation steps
+	//	int _getPartitionCount(Solution &) const - number of parts the neighborhood is split into for evaluation
+	//	void _evaluatePartition(Solution &, int, Candidates &) const - offers candidate steps from a part of the neighborhood
+	//The hooks must be accessible to this class (public, or befriend it).
+	//The tabu list policy can be changed e.g. to HashedTabuList for constant-time tabu checks.
+	//The candidate list strategy (see CandidateList) trades the quality of the chosen step for the cost of the partitioned evaluation.
+	//Cycles are detected by comparing the solution with the best one, or by the hashes of recently visited solutions if the solution is hashed.
+	template <class Derived, SearchSolution Solution, class Step, template <class> class TabuListPolicy = TabuList>
+		requires SearchStep<Step, Solution> && (std::equality_comparable<Solution> || HashedSolution<Solution>)
+	class StaticSearcher : public AlgorithmBase<Solution>, public IProfiled, public ICheckpointed {
 
 	  public:
 
-		explicit Searcher(const boost::property_tree::ptree &pt) : _tabuList(pt)
+		//Which parts of the partitioned neighborhood are evaluated in each step.
+		//Steps are sampled at the granularity of partitions, so the finer the partitions, the finer the choice.
+		enum class CandidateList {
+			full, //all partitions
+			sampled, //random sample of sampleSize partitions
+			first, //partitions in turns, until one offers an improving step (each thread evaluates one at a time)
+			elite //the eliteSize partitions with the best steps, chosen by evaluating all of them every eliteRefresh steps
+		};
+
+		//Accepts the candidate steps the searcher can take (see isAcceptableStep).
+		//A concrete type rather than std::function, so that the check of each candidate is inlined.
+		struct Acceptance {
+
+			bool operator()(const Step &step, Fitness currentFitness) const { return searcher->isAcceptableStep(step, currentFitness); }
+
+			const StaticSearcher *searcher;
+		};
+
+		//steps offered from a part of the neighborhood
+		using Candidates = CandidateSet<Step, Acceptance>;
+
+		explicit StaticSearcher(const boost::property_tree::ptree &pt)
+		:
+			_stepPool(pt.get("threads", 1) != 1),
+			_tabuList(pt, _randomEngine)
 		{
 			_config.load(pt);
 			_config.maxSteps = pt.get("maxSteps", 500);
@@ -36,6 +85,36 @@ namespace Algorithm::TabuSearch {
 			_config.fitnessNeutralPreDiscardRatio = pt.get("fitnessNeutralPreDiscardRatio", 0.0f);
 			_config.fitnessNeutralPostDiscardRatio = pt.get("fitnessNeutralPostDiscardRatio", 0.9f);
 			_config.neighborhood = pt.get<std::string>("neighborhood", "");
+			_config.threads = pt.get("threads", 1);
+			_config.journal = pt.get("journal", false);
+			_config.journalLimit = pt.get("journalLimit", _config.maxSteps);
+			_config.moveCache = pt.get("moveCache", false);
+			_config.candidateList = _parseCandidateList(pt.get<std::string>("candidateList", "full"));
+			_config.sampleSize = std::max(1, pt.get("sampleSize", 16));
+			_config.eliteSize = std::max(1, pt.get("eliteSize", 16));
+			_config.eliteRefresh = std::max(1, pt.get("eliteRefresh", 10));
+			_config.visitedLimit = std::max(0, pt.get("visitedLimit", 0));
+			if (_config.threads != 1)
+				_workers = std::make_unique<Private::WorkerPool>(_config.threads);
+
+			_randomEngine.seed(_config.seed);
+			_profiler.enable(_config.profile);
+
+			if constexpr (!UndoableStep<Step, Solution>) {
+				if (_config.journal)
+					throw std::runtime_error("Algorithm::TabuSearch::StaticSearcher: journal mode requires steps with undo");
+			}
+			if constexpr (!RegionalStep<Step, Solution>) {
+				if (_config.moveCache)
+					throw std::runtime_error("Algorithm::TabuSearch::StaticSearcher: move cache requires steps reporting their touched regions");
+			}
+			if constexpr (HashedSolution<Solution>)
+				_visited.resize(_config.visitedLimit);
+			else if (_config.visitedLimit > 0)
+				throw std::runtime_error("Algorithm::TabuSearch::StaticSearcher: visited solutions can only be tracked for hashed solutions");
+
+			if (_config.moveCache && _config.candidateList != CandidateList::full)
+				throw std::runtime_error("Algorithm::TabuSearch::StaticSearcher: move cache evaluates the full neighborhood, it can't be combined with other candidate lists");
 		}
 
 		struct Config : Algorithm::Config {
@@ -45,11 +124,35 @@ namespace Algorithm::TabuSearch {
 			float fitnessNeutralPreDiscardRatio; //probability of dicarding a fitness-neutral step before evaluation
 			float fitnessNeutralPostDiscardRatio; //probability of dicarding a non-bettering fitness-neutral step after evaluation
 			std::string neighborhood; //enables varying neighborhoods in implementation-specific best step getters
+			int threads; //how many threads evaluate the partitioned neighborhood (zero or less means all hardware threads)
+			bool journal; //track the best solution by journal of steps executed since it was found instead of copying it
+			int journalLimit; //max steps in the journal, the best solution is copied when exceeded
+			bool moveCache; //keep the evaluated neighborhood and evaluate again only the partitions touched by the executed step (see MoveCache)
+			CandidateList candidateList; //"full", "sampled", "first" or "elite"
+			int sampleSize; //partitions evaluated by the sampled candidate list
+			int eliteSize; //partitions kept by the elite candidate list
+			int eliteRefresh; //how many steps between evaluations of the full neighborhood by the elite candidate list
+			int visitedLimit; //how many steps back a revisited solution counts as a cycle (hashed solutions only, otherwise only returns to the best solution are detected)
 		};
 
-		void enableExtensions() noexcept final { _config.extended = true; }
-		void disableExtensions() noexcept final { _config.extended = false; }
+		void enableExtensions() noexcept final
+		{
+			_config.extended = true;
+			_moveCache.invalidateAll(); //the neighborhood may depend on the extensions
+		}
+
+		void disableExtensions() noexcept final
+		{
+			_config.extended = false;
+			_moveCache.invalidateAll();
+		}
+
 		const Config &getConfig() const noexcept { return _config; }
+		Stats getStats() const noexcept final { return _profiler.stats(); }
+
+		//the tabu list, move cache, candidate lists and visited solutions start afresh in each run, only the random stream carries over
+		void saveState(Checkpoint::Writer &out) const final { out.write(_randomEngine.state()); }
+		void loadState(Checkpoint::Reader &in) final { _randomEngine.setState(in.read<std::array<std::uint64_t, 4>>()); }
 
 		//Assesses given step in the context of the running algorithm to see if it's a candidate for continuation.
 		//Returns true if the step can be considered as the next one to take.
@@ -57,15 +160,145 @@ namespace Algorithm::TabuSearch {
 		//which is therefore not safe to be accessed
 		bool isAcceptableStep(const Step &step, Fitness currentFitness) const
 		{
-			return _isAspirationStep(step, currentFitness) || !_tabuList.isTabu(step);
+			_profiler.count(Phase::tabuCheck); //only counted, timing each check would cost more than the check itself
+			if (_isAspirationStep(step, currentFitness)) {
+				_profiler.count(Phase::aspiration);
+				return true;
+			}
+			return !_tabuList.isTabu(step);
 		}
 
 	  protected:
 
 		void executeStep(Solution &solution, const std::shared_ptr<Step> &step)
 		{
+			const Private::Profiler::Scope _{_profiler, Phase::stepExecution};
 			step->execute(solution);
 			_tabuList.insert(step);
+			if constexpr (RegionalStep<Step, Solution>) {
+				if (_config.moveCache) {
+					_touchedRegions.clear();
+					step->touchedRegions(solution, _touchedRegions);
+					for (int region : _touchedRegions)
+						_moveCache.invalidate(region);
+				}
+			}
+			if (_config.journal && !_bestSolutionPtr)
+				_journalStep(solution, step);
+		}
+
+		//Call when the cached steps are no longer valid for reasons other than executed steps, e.g. when the adapted fitness changes.
+		void invalidateMoveCache() noexcept
+		{
+			_moveCache.invalidateAll();
+		}
+
+		//Creates a step using memory recycled by the searcher, use instead of std::make_shared when generating candidates.
+		//The step must not outlive the searcher.
+		template <class ConcreteStep = Step, class... Args>
+		std::shared_ptr<ConcreteStep> makeStep(Args &&...args) const
+		{
+			return _stepPool.template make<ConcreteStep>(std::forward<Args>(args)...);
+		}
+
+		//default hooks
+
+		bool _init(Solution &) { return true; }
+
+		//evaluates the partitioned neighborhood, which must not be empty, so that a searcher providing neither hook fails instead of idling
+		std::vector<std::shared_ptr<Step>> _getBestSteps(Solution &solution) const
+		{
+			if (_derived()._getPartitionCount(solution) <= 0)
+				throw std::logic_error("Algorithm::TabuSearch::StaticSearcher::_getBestSteps: no neighborhood partitions, provide _getBestSteps or _getPartitionCount");
+
+			return _evaluateNeighborhood(solution);
+		}
+
+		int _getPartitionCount(Solution &) const { return 0; }
+
+		void _evaluatePartition(Solution &, int /*partition*/, Candidates &) const {}
+
+		//Evaluates the parts of the neighborhood chosen by the candidate list, in parallel if enabled, and merges their best steps.
+		//The merge is done in the order of the chosen partitions, so the result doesn't depend on thread scheduling
+		//and runs with a fixed seed are reproducible with any number of threads.
+		std::vector<std::shared_ptr<Step>> _evaluateNeighborhood(Solution &solution) const
+		{
+			if (_config.moveCache)
+				return _evaluateCachedNeighborhood(solution);
+
+			const int count{_derived()._getPartitionCount(solution)};
+			const Fitness current{solution.getFitness()};
+			while (static_cast<int>(_partitions.size()) < count) {
+				_partitions.emplace_back(Acceptance{this});
+			}
+
+			bool rebuildElite{false};
+			switch (_config.candidateList) {
+				case CandidateList::full:
+					_selectAll(count);
+					_evaluatePartitions(solution, current, 0, count);
+					break;
+				case CandidateList::sampled:
+					_selectSample(count);
+					_evaluatePartitions(solution, current, 0, static_cast<int>(_selected.size()));
+					break;
+				case CandidateList::first:
+					_evaluateUntilImprovement(solution, current, count);
+					break;
+				case CandidateList::elite:
+					rebuildElite = _elitePartitionCount != count || _eliteAge >= _config.eliteRefresh;
+					if (rebuildElite)
+						_selectAll(count);
+					else
+						_selected = _elite;
+
+					_eliteAge++;
+					_evaluatePartitions(solution, current, 0, static_cast<int>(_selected.size()));
+					break;
+			}
+
+			auto bestDelta = AdaptedFitness::worstDelta();
+			for (int partition : _selected)
+				bestDelta = std::min(bestDelta, _partitions[partition].bestDelta());
+
+			std::vector<std::shared_ptr<Step>> steps;
+			for (int partition : _selected) {
+				auto const &candidates = _partitions[partition];
+				if (!candidates.steps().empty() && candidates.bestDelta() == bestDelta)
+					steps.insert(steps.end(), candidates.steps().begin(), candidates.steps().end());
+			}
+
+			if (_config.candidateList == CandidateList::elite) {
+				if (rebuildElite)
+					_rebuildElite(count);
+				else if (steps.empty()) {
+					//the elite has nothing acceptable left, look at the whole neighborhood again
+					_eliteAge = _config.eliteRefresh;
+					return _evaluateNeighborhood(solution);
+				}
+			}
+			return steps;
+		}
+
+		//Evaluates again only the partitions touched since the last evaluation, in parallel if enabled.
+		//The partitions must offer all their steps, as the acceptability of the cached steps changes with the tabu list.
+		std::vector<std::shared_ptr<Step>> _evaluateCachedNeighborhood(Solution &solution) const
+		{
+			const Fitness current{solution.getFitness()};
+			_moveCache.resize(_derived()._getPartitionCount(solution));
+			auto const &dirty = _moveCache.beginUpdate(current);
+			auto const evaluate = [this, &solution, &dirty](int i) {
+				_derived()._evaluatePartition(solution, dirty[i], _moveCache.region(dirty[i]));
+			};
+			if (_workers)
+				_workers->run(static_cast<int>(dirty.size()), evaluate);
+			else {
+				for (int i = 0; i < static_cast<int>(dirty.size()); ++i)
+					evaluate(i);
+			}
+			_moveCache.commit();
+
+			return _moveCache.bestSteps(current, Acceptance{this});
 		}
 
 	  private:
@@ -74,18 +307,26 @@ namespace Algorithm::TabuSearch {
 		bool _run(Solution &solution) noexcept(false) final
 		{
 			_tabuList.clear();
-			_bestSolutionPtr = std::make_unique<Solution>(solution);
+			_moveCache.invalidateAll(); //the solution may have changed since the last run
+			_elitePartitionCount = -1; //likewise the elite
+			_nextPartition = 0;
+			_visited.clear();
+			_resetBest(solution);
 			Fitness bestFeasible{solution.isFeasible() ? solution.getFitness() : Fitness::worst()}; //holds the fitness of the best feasible solution found so far
-			if (!_init(solution))
+			if (!_derived()._init(solution))
 				return false;
 
 			const int maxSteps{_config.maxSteps * (_config.extended ? 2 : 1)};
 			bool improved{false};
 			int executedSteps{0};
 			int noImprovements{0};
-			while (!this->isStopRequested() && !_bestSolutionPtr->getFitness().isZero() && (noImprovements < maxSteps)) {
+			while (!this->isStopRequested() && !_bestFitness.isZero() && (noImprovements < maxSteps)) {
 				noImprovements++;
-				auto possibleSteps = _getBestSteps(solution);
+				std::vector<std::shared_ptr<Step>> possibleSteps;
+				{
+					const Private::Profiler::Scope _{_profiler, Phase::neighborhood};
+					possibleSteps = _derived()._getBestSteps(solution);
+				}
 
 				//update the tabu list now so that new entries added when executing the step stay intact for next step
 				//also to possibly allow some steps for next move in case no steps have just been found
@@ -94,34 +335,35 @@ namespace Algorithm::TabuSearch {
 				auto nextStep = _getNextStep(possibleSteps);
 				if (nextStep) {
 					//can be null if there are no possible steps at this point - might be all tabu
-					Ctoolhu::Event::Fire(Events::BeforeStep{&solution});
-
-					//record step data before execution
-					std::stringstream s;
-					nextStep->dump(s);
+					if (Algorithm::Events::isHeard<Events::BeforeStep>()) {
+						const Private::Profiler::Scope _{_profiler, Phase::events};
+						Ctoolhu::Event::Fire(Events::BeforeStep{&solution});
+					}
 
 					const Fitness expected{solution.getFitness() + nextStep->delta()};
 					executeStep(solution, nextStep);
 					executedSteps++;
-					const Fitness actual{solution.getFitness()};
-					if (actual != expected)
-						throw std::logic_error("Algorithm::TabuSearch::Searcher::run: unexpected fitness after step execution");
+					const Fitness actual{_checkFitness(solution, expected)};
+					{
+						const Private::Profiler::Scope _{_profiler, Phase::events};
+						if (Algorithm::Events::isHeard<Events::StepExecuted>()) {
+							Ctoolhu::Event::Fire(Events::StepExecuted {
+								_config.dynamicAdaptationThreshold,
+								&solution,
+								Events::StepView{*nextStep},
+								_config.keepFeasible
+							});
+						}
 
-					Ctoolhu::Event::Fire(Events::StepExecuted {
-						_config.dynamicAdaptationThreshold,
-						&solution,
-						s.str(),
-						_config.keepFeasible
-					});
+						if (Algorithm::Events::isHeard<Algorithm::Events::CurrentSolutionChanged>())
+							Algorithm::Events::publish<Solution>(Algorithm::Events::CurrentSolutionChanged { &solution, this->elapsedTime() });
+					}
 
-					Ctoolhu::Event::Fire(Algorithm::Events::CurrentSolutionChanged { &solution, this->elapsedTime() });
+					if (Algorithm::Events::isHeard<Events::CycleDetected>())
+						_detectCycle(solution, actual, noImprovements, executedSteps);
 
 					bool foundBest{false};
-					if (actual == _bestSolutionPtr->getFitness()) {
-						//check for cycling, but only compare structure if the fitness is the same, comparison can be computationally expensive
-						if (solution == *_bestSolutionPtr)
-							Ctoolhu::Event::Fire(Events::CycleDetected { noImprovements });
-
+					if (actual == _bestFitness) {
 						if (noImprovements == maxSteps && _retainsFeasibility(solution)) {
 							//this is the last step, accept current solution as the best to improve success chances of chained algorithm,
 							//which will continue from this solution as opposed to try with the original solution again
@@ -129,31 +371,38 @@ namespace Algorithm::TabuSearch {
 						}
 					}
 					//check if new best solution was found, in that case store it
-					else if (actual < _bestSolutionPtr->getFitness() && _retainsFeasibility(solution)) {
+					else if (actual < _bestFitness && _retainsFeasibility(solution)) {
 						noImprovements = 0;
 						improved = true;
 						foundBest = true;
 					}
 					if (foundBest) {
-						*_bestSolutionPtr = solution;
-						Ctoolhu::Event::Fire(Algorithm::Events::BestSolutionFound { &solution, this->elapsedTime() });
+						_updateBest(solution);
+						const Private::Profiler::Scope _{_profiler, Phase::events};
+						Algorithm::Events::publish<Solution>(Algorithm::Events::BestSolutionFound { &solution, this->elapsedTime() });
 					}
 					if (solution.isFeasible() && actual < bestFeasible) {
 						bestFeasible = actual;
-						Ctoolhu::Event::Fire(Algorithm::Events::FeasibleSolutionFound { &solution, this->elapsedTime() });
+						const Private::Profiler::Scope _{_profiler, Phase::events};
+						Algorithm::Events::publish<Solution>(Algorithm::Events::FeasibleSolutionFound { &solution, this->elapsedTime() });
 					}
 				}
-				Ctoolhu::Event::Fire(Events::AfterStep { noImprovements });
+				if (Algorithm::Events::isHeard<Events::AfterStep>()) {
+					const Private::Profiler::Scope _{_profiler, Phase::events};
+					Ctoolhu::Event::Fire(Events::AfterStep { noImprovements }); //synchronous, the listeners can react before the next step
+				}
 			}
 
 			//Cycle is finished with some solution, make sure we use one with the best fitness found, preferring current to the saved best if equal.
 			//The reason is that next algorithm in the chain can have a chance to work on a different solution than in the previous cycle.
-			if (solution.getFitness() > _bestSolutionPtr->getFitness()) {
-				solution = *_bestSolutionPtr;
-				Ctoolhu::Event::Fire(Algorithm::Events::CurrentSolutionChanged { &solution, this->elapsedTime() });
+			if (solution.getFitness() > _bestFitness) {
+				_restoreBest(solution);
+				Algorithm::Events::publish<Solution>(Algorithm::Events::CurrentSolutionChanged { &solution, this->elapsedTime() });
 			}
 
-			Ctoolhu::Event::Fire(Events::Finished { &solution, executedSteps, this->elapsedTime() });
+			if (!Algorithm::Events::Silenced::isActive())
+				Ctoolhu::Event::Fire(Events::Finished { &solution, executedSteps, this->elapsedTime() });
+
 			return improved;
 		}
 
@@ -167,33 +416,284 @@ namespace Algorithm::TabuSearch {
 				case 1:
 					return steps[0];
 				default: {
-					Ctoolhu::Event::Fire(Events::AfterRandomStepChosen { static_cast<int>(steps.size()) });
-					return Ctoolhu::Random::Select(steps);
+					if (Algorithm::Events::isHeard<Events::AfterRandomStepChosen>())
+						Ctoolhu::Event::Fire(Events::AfterRandomStepChosen { static_cast<int>(steps.size()) });
+
+					return steps[_randomEngine.below(static_cast<std::uint32_t>(steps.size()))];
 				}
 			}
 		}
 
+		static CandidateList _parseCandidateList(const std::string &name)
+		{
+			if (name == "full")
+				return CandidateList::full;
+			if (name == "sampled")
+				return CandidateList::sampled;
+			if (name == "first")
+				return CandidateList::first;
+			if (name == "elite")
+				return CandidateList::elite;
+
+			throw std::runtime_error("Algorithm::TabuSearch::StaticSearcher: unknown candidate list '" + name + "'");
+		}
+
+		void _selectAll(int count) const
+		{
+			_selected.resize(count);
+			std::iota(_selected.begin(), _selected.end(), 0);
+		}
+
+		//chooses sampleSize partitions at random (partial Fisher-Yates shuffle), in partition order
+		void _selectSample(int count) const
+		{
+			if (static_cast<int>(_shuffled.size()) != count) {
+				_shuffled.resize(count);
+				std::iota(_shuffled.begin(), _shuffled.end(), 0);
+			}
+			const int size{std::min(count, _config.sampleSize)};
+			for (int i = 0; i < size; ++i)
+				std::swap(_shuffled[i], _shuffled[i + static_cast<int>(_randomEngine.below(static_cast<std::uint32_t>(count - i)))]);
+
+			_selected.assign(_shuffled.begin(), _shuffled.begin() + size);
+			std::sort(_selected.begin(), _selected.end());
+		}
+
+		//evaluates the selected partitions in the given range
+		void _evaluatePartitions(Solution &solution, Fitness current, int begin, int end) const
+		{
+			for (int i = begin; i < end; ++i)
+				_partitions[_selected[i]].reset(current);
+
+			auto const evaluate = [this, &solution, begin](int i) {
+				const int partition{_selected[begin + i]};
+				_derived()._evaluatePartition(solution, partition, _partitions[partition]);
+			};
+			if (_workers)
+				_workers->run(end - begin, evaluate);
+			else {
+				for (int i = 0; i < end - begin; ++i)
+					evaluate(i);
+			}
+		}
+
+		//Evaluates the partitions in turns, continuing after the last one evaluated in the previous step, until an improving step is found.
+		//Each round evaluates one partition per thread, so the rounds and thus the result don't depend on thread scheduling.
+		void _evaluateUntilImprovement(Solution &solution, Fitness current, int count) const
+		{
+			_selected.clear();
+			if (count == 0)
+				return;
+
+			const int round{_workers ? _workers->size() : 1};
+			int first{_nextPartition % count};
+			while (static_cast<int>(_selected.size()) < count) {
+				const int begin{static_cast<int>(_selected.size())};
+				const int end{std::min(count, begin + round)};
+				for (int i = begin; i < end; ++i)
+					_selected.push_back((first + i) % count);
+
+				_evaluatePartitions(solution, current, begin, end);
+				if (std::any_of(_selected.begin() + begin, _selected.end(), [this](int partition) { return _partitions[partition].bestDelta() < 0; }))
+					break;
+			}
+			_nextPartition = (first + static_cast<int>(_selected.size())) % count;
+		}
+
+		//keeps the partitions with the best steps, as just evaluated, in partition order
+		void _rebuildElite(int count) const
+		{
+			_elite.clear();
+			for (int partition = 0; partition < count; ++partition) {
+				if (!_partitions[partition].steps().empty())
+					_elite.push_back(partition);
+			}
+			if (static_cast<int>(_elite.size()) > _config.eliteSize) {
+				auto const isBetter = [this](int a, int b) {
+					return std::pair{_partitions[a].bestDelta(), a} < std::pair{_partitions[b].bestDelta(), b};
+				};
+				std::nth_element(_elite.begin(), _elite.begin() + _config.eliteSize, _elite.end(), isBetter);
+				_elite.resize(_config.eliteSize);
+				std::sort(_elite.begin(), _elite.end());
+			}
+			_elitePartitionCount = count;
+			_eliteAge = 1;
+		}
+
 		//aspiration steps are allowed to happen even if they are in the tabu list
 		bool _isAspirationStep(const Step &step, Fitness currentFitness) const
 		{
-			return (currentFitness + step.delta()) < _bestSolutionPtr->getFitness();
+			return (currentFitness + step.delta()) < _bestFitness;
 		}
 
 		bool _retainsFeasibility(Solution &solution) const
 		{
-			return !_config.keepFeasible || !_bestSolutionPtr->isFeasible() || solution.isFeasible();
+			return !_config.keepFeasible || !_isBestFeasible || solution.isFeasible();
 		}
 
+		//Fires CycleDetected if the search returned to the best solution, or to any solution visited within the visited limit.
+		//The event is fired synchronously, so that the listeners can break the cycle (e.g. by adapting the fitness) before the next step.
+		//Hashed solutions are recognized in constant time, otherwise the structure is compared with the best solution,
+		//but only if the fitness is the same, as comparison can be computationally expensive
+		//(not available in journal mode, unless the best solution has been copied).
+		void _detectCycle(Solution &solution, Fitness actual, int noImprovements, int executedSteps)
+		{
+			if constexpr (HashedSolution<Solution>) {
+				const std::uint64_t hash{solution.hash()};
+				const int previous{_visited.visit(hash, executedSteps)};
+				if (previous >= 0 || (actual == _bestFitness && hash == _bestHash)) {
+					const Private::Profiler::Scope _{_profiler, Phase::events};
+					Ctoolhu::Event::Fire(Events::CycleDetected { noImprovements, previous >= 0 ? executedSteps - previous : 0 });
+				}
+			}
+			else if (actual == _bestFitness && _bestSolutionPtr && solution == *_bestSolutionPtr) {
+				const Private::Profiler::Scope _{_profiler, Phase::events};
+				Ctoolhu::Event::Fire(Events::CycleDetected { noImprovements, 0 });
+			}
+		}
+
+		//returns the fitness of the solution after a step, which must be the expected one
+		Fitness _checkFitness(Solution &solution, Fitness expected) const
+		{
+			const Private::Profiler::Scope _{_profiler, Phase::fitnessCheck};
+			const Fitness actual{solution.getFitness()};
+			if (actual != expected)
+				throw std::logic_error("Algorithm::TabuSearch::StaticSearcher::run: unexpected fitness after step execution");
+
+			return actual;
+		}
+
+		//start tracking the best solution from the given one
+		void _resetBest(Solution &solution)
+		{
+			const Private::Profiler::Scope _{_profiler, Phase::bestCopy};
+			_journal.clear();
+			if (_config.journal)
+				_bestSolutionPtr.reset();
+			else
+				_bestSolutionPtr = std::make_unique<Solution>(solution);
+
+			_bestFitness = solution.getFitness();
+			_isBestFeasible = solution.isFeasible();
+			if constexpr (HashedSolution<Solution>) {
+				_bestHash = solution.hash();
+				_visited.visit(_bestHash, 0);
+			}
+		}
+
+		//current solution becomes the best
+		void _updateBest(Solution &solution)
+		{
+			const Private::Profiler::Scope _{_profiler, Phase::bestCopy};
+			if (_config.journal) {
+				_journal.clear();
+				_bestSolutionPtr.reset();
+			}
+			else
+				*_bestSolutionPtr = solution;
+
+			_bestFitness = solution.getFitness();
+			_isBestFeasible = solution.isFeasible();
+			if constexpr (HashedSolution<Solution>)
+				_bestHash = solution.hash();
+		}
+
+		//turn the current solution back into the best one
+		void _restoreBest(Solution &solution)
+		{
+			const Private::Profiler::Scope _{_profiler, Phase::bestCopy};
+			_moveCache.invalidateAll();
+			if (_bestSolutionPtr)
+				solution = *_bestSolutionPtr;
+			else
+				_rollBack(solution);
+		}
+
+		void _journalStep(Solution &solution, const std::shared_ptr<Step> &step)
+		{
+			_journal.push_back(step);
+			if (static_cast<int>(_journal.size()) > _config.journalLimit) {
+				//too long to keep, materialize the best solution from a copy of the current one
+				_bestSolutionPtr = std::make_unique<Solution>(solution);
+				_rollBack(*_bestSolutionPtr);
+			}
+		}
+
+		//undo steps in the journal, last to first
+		void _rollBack(Solution &solution)
+		{
+			if constexpr (UndoableStep<Step, Solution>) {
+				for (auto it = _journal.rbegin(); it != _journal.rend(); ++it)
+					(*it)->undo(solution);
+
+				_journal.clear();
+				if (solution.getFitness() != _bestFitness)
+					throw std::logic_error("Algorithm::TabuSearch::StaticSearcher::_rollBack: unexpected fitness after undoing the journal");
+			}
+		}
+
+		const Derived &_derived() const noexcept { return static_cast<const Derived &>(*this); }
+		Derived &_derived() noexcept { return static_cast<Derived &>(*this); }
+
+		Config _config;
+		std::unique_ptr<Solution> _bestSolutionPtr; //holds best solution found so far (in journal mode only if the journal overflowed)
+		Fitness _bestFitness;
+		bool _isBestFeasible{false};
+		std::uint64_t _bestHash{0}; //of the best solution, if hashed (known even in journal mode)
+		mutable Private::FastRandom _randomEngine; //must be declared before the tabu list, which uses it
+		StepPool<Step> _stepPool; //must be declared before all members holding steps, so that it's destroyed after them
+		TabuListPolicy<Step> _tabuList; //list of tabu steps
+		mutable MoveCache<Step, Acceptance> _moveCache; //steps of the neighborhood evaluated in previous iterations, if enabled
+		std::vector<int> _touchedRegions; //reused when invalidating the move cache
+		std::vector<std::shared_ptr<Step>> _journal; //steps executed since the best solution was found, in journal mode
+		VisitedSet _visited; //hashes of the solutions visited within the visited limit, if hashed
+		std::unique_ptr<Private::WorkerPool> _workers; //parallel neighborhood evaluation, null if single-threaded
+		mutable std::vector<Candidates> _partitions; //best steps of each neighborhood part, reused between steps
+		mutable std::vector<int> _selected; //partitions evaluated in the current step, chosen by the candidate list
+		mutable std::vector<int> _shuffled; //permutation of the partitions, for sampling
+		mutable std::vector<int> _elite; //partitions evaluated between refreshes of the elite candidate list
+		mutable int _elitePartitionCount{-1}; //number of partitions when the elite was chosen, -1 if not chosen yet
+		mutable int _eliteAge{0}; //steps since the elite was chosen
+		mutable int _nextPartition{0}; //where the first-improvement candidate list continues
+		Private::Profiler _profiler;
+	};
+
+	template <class Solution, class Step, template <class> class TabuListPolicy = TabuList, class Enable = void>
+	class Searcher;
+
+	//Tabu search algorithm
+	//Dynamically dispatched, derive from it and override the hooks.
+	template <class Solution, class Step, template <class> class TabuListPolicy>
+	class Searcher<Solution, Step, TabuListPolicy, typename std::enable_if<std::is_base_of<IStep<Solution>, Step>::value>::type>
+		: public StaticSearcher<Searcher<Solution, Step, TabuListPolicy>, Solution, Step, TabuListPolicy>
+	{
+		using base_t = StaticSearcher<Searcher<Solution, Step, TabuListPolicy>, Solution, Step, TabuListPolicy>;
+		friend base_t;
+
+	  public:
+
+		using base_t::base_t;
+
+	  private:
+
 		//Prepare for getting best steps, if necessary.
 		//Return false if algorithm cannot run.
 		virtual bool _init(Solution &) { return true; }
 
-		//get container with continuation steps for the tabu search
-		virtual std::vector<std::shared_ptr<Step>> _getBestSteps(Solution &) const = 0;
+		//Get container with continuation steps for the tabu search.
+		//Unless overridden, the partitioned neighborhood is evaluated (see _getPartitionCount), throws if it has no partitions.
+		virtual std::vector<std::shared_ptr<Step>> _getBestSteps(Solution &solution) const
+		{
+			return base_t::_getBestSteps(solution);
+		}
 
-		Config _config;
-		std::unique_ptr<Solution> _bestSolutionPtr; //holds best solution found so far
-		TabuList<Step> _tabuList; //list of tabu steps
+		//Returns the number of parts the neighborhood of the solution is split into for evaluation.
+		//Only used by the default implementation of _getBestSteps.
+		virtual int _getPartitionCount(Solution &) const { return 0; }
+
+		//Offers candidate steps from the given part of the neighborhood to the candidate set.
+		//Parts can be evaluated concurrently (see Config::threads), so the solution must be treated as read-only.
+		virtual void _evaluatePartition(Solution &, int /*partition*/, typename base_t::Candidates &) const {}
 	};
 
 } //ns Algorithm::TabuSearch
@@ -0,0 +1,118 @@
+#ifndef _algorithm_visited_set_included_
+#define _algorithm_visited_set_included_
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Algorithm::TabuSearch {
+
+	//Hashes of the solutions visited in the last few steps of the search, with the step of their last visit.
+	//Tells in constant time whether the search returned to a recent solution, and how long the cycle was.
+	//Open addressing with linear probing, the oldest visit is forgotten once the limit is reached.
+	class VisitedSet {
+
+	  public:
+
+		//remembers the visits of the last limit steps
+		explicit VisitedSet(int limit = 0)
+		{
+			resize(limit);
+		}
+
+		void resize(int limit)
+		{
+			_recent.assign(std::max(0, limit), Visit{});
+			_slots.assign(std::bit_ceil(_recent.size() * 2 + 1), Visit{});
+			_mask = _slots.size() - 1;
+			_next = 0;
+		}
+
+		void clear()
+		{
+			std::ranges::fill(_recent, Visit{});
+			std::ranges::fill(_slots, Visit{});
+			_next = 0;
+		}
+
+		int limit() const noexcept { return static_cast<int>(_recent.size()); }
+
+		//Records the visit of the solution with the hash in the step.
+		//Returns the step of its previous visit, or -1 if it wasn't visited within the limit.
+		int visit(std::uint64_t hash, int step)
+		{
+			if (_recent.empty())
+				return -1;
+
+			auto &slot = _slots[_find(hash)];
+			const int previous{slot.step};
+			if (previous >= 0)
+				slot.step = step; //also keeps it from being forgotten with its previous visit
+
+			auto &oldest = _recent[_next];
+			if (oldest.step >= 0)
+				_forget(oldest);
+
+			oldest = Visit{hash, step};
+			if (++_next == _recent.size())
+				_next = 0;
+
+			if (previous < 0)
+				_slots[_find(hash)] = Visit{hash, step}; //forgetting may have moved the slots
+			return previous;
+		}
+
+	  private:
+
+		struct Visit {
+			std::uint64_t hash{0};
+			int step{-1}; //negative if empty
+		};
+
+		std::size_t _home(std::uint64_t hash) const noexcept
+		{
+			return static_cast<std::size_t>(hash ^ (hash >> 32)) & _mask;
+		}
+
+		//slot of the hash, or the empty slot where it belongs
+		std::size_t _find(std::uint64_t hash) const noexcept
+		{
+			std::size_t i{_home(hash)};
+			while (_slots[i].step >= 0 && _slots[i].hash != hash)
+				i = (i + 1) & _mask;
+
+			return i;
+		}
+
+		//removes the visit from the table, unless the solution was visited again since
+		void _forget(const Visit &visit)
+		{
+			std::size_t i{_find(visit.hash)};
+			if (_slots[i].step != visit.step)
+				return; //visited again since
+
+			//shift back the following entries that would no longer be reachable from their home slot
+			for (std::size_t j{i};;) {
+				j = (j + 1) & _mask;
+				if (_slots[j].step < 0)
+					break;
+
+				if (((j - _home(_slots[j].hash)) & _mask) >= ((j - i) & _mask)) {
+					_slots[i] = _slots[j];
+					i = j;
+				}
+			}
+			_slots[i] = Visit{};
+		}
+
+		std::vector<Visit> _recent; //circular, visits in the order of steps
+		std::vector<Visit> _slots; //hash table of the last visit of each remembered solution
+		std::size_t _mask{0};
+		std::size_t _next{0}; //position of the oldest visit in _recent
+	};
+
+} //ns Algorithm::TabuSearch
+
+#endif //file guard
@@ -0,0 +1,132 @@
+#ifndef _algorithm_worker_pool_included_
+#define _algorithm_worker_pool_included_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Algorithm::Private {
+
+	//Fixed set of threads executing indexed tasks in parallel.
+	//The calling thread takes part in the work, so a pool of size 1 doesn't start any threads.
+	class WorkerPool {
+
+	  public:
+
+		using task_t = std::function<void(int)>;
+
+		//size of zero or less means one worker per hardware thread
+		explicit WorkerPool(int size)
+		{
+			if (size <= 0)
+				size = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+			for (int i = 1; i < size; ++i)
+				_threads.emplace_back([this] { _work(); });
+		}
+
+		~WorkerPool()
+		{
+			{
+				std::lock_guard _{_mutex};
+				_quit = true;
+			}
+			_wake.notify_all();
+			for (auto &thread : _threads)
+				thread.join();
+		}
+
+		WorkerPool(const WorkerPool &) = delete;
+		WorkerPool(WorkerPool &&) = delete;
+		WorkerPool &operator=(const WorkerPool &) = delete;
+		WorkerPool &operator=(WorkerPool &&) = delete;
+
+		int size() const noexcept { return static_cast<int>(_threads.size()) + 1; }
+
+		//Calls task(i) for each i in [0, count) and returns when all the calls are finished.
+		//Rethrows the first exception thrown by a task (the remaining tasks still run).
+		void run(int count, const task_t &task)
+		{
+			if (_threads.empty() || count < 2) {
+				for (int i = 0; i < count; ++i)
+					task(i);
+
+				return;
+			}
+
+			{
+				std::lock_guard _{_mutex};
+				_task = &task;
+				_count = count;
+				_next = 0;
+				_busy = static_cast<int>(_threads.size());
+				++_generation;
+			}
+			_wake.notify_all();
+			_consume();
+
+			std::unique_lock lock{_mutex};
+			_done.wait(lock, [this] { return _busy == 0; });
+			_task = nullptr;
+			if (_error)
+				std::rethrow_exception(std::exchange(_error, nullptr));
+		}
+
+	  private:
+
+		void _work()
+		{
+			unsigned seenGeneration{0};
+			std::unique_lock lock{_mutex};
+			while (true) {
+				_wake.wait(lock, [&] { return _quit || _generation != seenGeneration; });
+				if (_quit)
+					return;
+
+				seenGeneration = _generation;
+				lock.unlock();
+				_consume();
+				lock.lock();
+				if (--_busy == 0)
+					_done.notify_one();
+			}
+		}
+
+		//takes task indices until there are none left
+		void _consume()
+		{
+			for (int i = _next++; i < _count; i = _next++) {
+				try {
+					(*_task)(i);
+				}
+				catch (...) {
+					std::lock_guard _{_mutex};
+					if (!_error)
+						_error = std::current_exception();
+				}
+			}
+		}
+
+		std::vector<std::thread> _threads;
+		std::mutex _mutex;
+		std::condition_variable _wake; //signals workers that a new batch of tasks is available
+		std::condition_variable _done; //signals the caller that all workers have finished the batch
+
+		const task_t *_task{nullptr};
+		int _count{0};
+		std::atomic<int> _next{0}; //index of the next task to take
+		int _busy{0}; //number of workers still consuming the current batch
+		unsigned _generation{0}; //incremented with each batch so that workers don't take the same batch twice
+		bool _quit{false};
+		std::exception_ptr _error;
+	};
+
+} //ns Algorithm::Private
+
+#endif //file guard
@@ -0,0 +1,42 @@
+#ifndef _algorithm_zobrist_table_included_
+#define _algorithm_zobrist_table_included_
+
+#include "random.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace Algorithm {
+
+	//Random keys for Zobrist hashing of solutions that assign one of a fixed set of values to each of their elements
+	//(e.g. a color to each vertex, a slot to each lesson), see HashedSolution.
+	//The hash of a solution is the xor of the keys of its assignments, so a step changing the value of an element
+	//updates it in constant time: hash ^= key(element, from) ^ key(element, to).
+	//The keys depend only on the seed, so the hashes of equal solutions match across runs and instances of the table.
+	class ZobristTable {
+
+	  public:
+
+		ZobristTable(int elements, int values, std::uint64_t seed = 0)
+		:
+			_values{values},
+			_keys(static_cast<std::size_t>(elements) * values)
+		{
+			Private::FastRandom random{seed};
+			for (auto &key : _keys)
+				key = random();
+		}
+
+		std::uint64_t key(int element, int value) const noexcept { return _keys[static_cast<std::size_t>(element) * _values + value]; }
+
+		//hash of the element changing its value
+		std::uint64_t change(int element, int from, int to) const noexcept { return key(element, from) ^ key(element, to); }
+
+	  private:
+
+		int _values;
+		std::vector<std::uint64_t> _keys; //elements x values
+	};
+
+} //ns Algorithm
+
+#endif //file guard
@@ -0,0 +1,149 @@
+#ifndef _algorithm_elite_pool_included_
+#define _algorithm_elite_pool_included_
+
+#include "fitness.hpp"
+#include "algorithm/random.hpp"
+#include "interface/isolution.h"
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Algorithm::Storage {
+
+	//solutions whose closeness can be told by the ElitePool
+	template <class Solution>
+	concept EliteSolution = DistanceSolution<Solution> || HashedSolution<Solution> || std::equality_comparable<Solution>;
+
+	//Thread-safe pool of the best mutually distinct solutions found, e.g. to restart searches from (see ChainedSearch).
+	//Solutions closer than the minimum distance count as the same, and only the better one of them is kept,
+	//so that the pool doesn't fill up with variations of a single solution.
+	//The distance is measured by the solutions if they can (DistanceSolution), otherwise only equal solutions are close,
+	//recognized by their hashes (HashedSolution) or by comparison.
+	template <class Solution>
+	class ElitePool {
+
+	  public:
+
+		//immutable copy of a solution in the pool, stays valid after it's replaced
+		struct Member {
+			Solution solution;
+			Fitness fitness; //at the time of insertion
+			bool feasible;
+		};
+
+		using member_ptr_t = std::shared_ptr<const Member>;
+
+		explicit ElitePool(int capacity, int minDistance = 1)
+		:
+			_capacity{std::max(1, capacity)},
+			_minDistance{std::max(1, minDistance)}
+		{
+			_members.reserve(_capacity);
+		}
+
+		//Offers a copy of the solution to the pool, returns true if it was admitted.
+		//It replaces the members close to it if it's better than all of them, or the worst member if the pool is full.
+		//Solutions no better than the worst member of a full pool are turned down without locking.
+		bool insert(Solution &solution)
+		{
+			const Fitness fitness{solution.getFitness()};
+			if (fitness - Fitness{0} >= _threshold.load(std::memory_order_relaxed))
+				return false;
+
+			const bool feasible{solution.isFeasible()};
+			std::lock_guard _{_mutex};
+			for (auto const &member : _members) {
+				if (member->fitness <= fitness && _isClose(member->solution, solution))
+					return false;
+			}
+			std::erase_if(_members, [this, &solution](const member_ptr_t &member) {
+				return _isClose(member->solution, solution);
+			});
+			if (static_cast<int>(_members.size()) == _capacity) {
+				if (_members.back()->fitness <= fitness)
+					return false;
+
+				_members.pop_back();
+			}
+
+			auto member = std::make_shared<const Member>(Member{solution, fitness, feasible});
+			auto const position = std::upper_bound(_members.begin(), _members.end(), fitness, [](Fitness f, const member_ptr_t &m) { return f < m->fitness; });
+			_members.insert(position, std::move(member));
+			_updateThreshold();
+			return true;
+		}
+
+		//uniformly chosen member, null if the pool is empty
+		member_ptr_t sample(Private::FastRandom &random) const
+		{
+			std::lock_guard _{_mutex};
+			if (_members.empty())
+				return nullptr;
+
+			return _members[random.below(static_cast<std::uint32_t>(_members.size()))];
+		}
+
+		//null if the pool is empty
+		member_ptr_t best() const
+		{
+			std::lock_guard _{_mutex};
+			return _members.empty() ? nullptr : _members.front();
+		}
+
+		//best first
+		std::vector<member_ptr_t> members() const
+		{
+			std::lock_guard _{_mutex};
+			return _members;
+		}
+
+		int size() const
+		{
+			std::lock_guard _{_mutex};
+			return static_cast<int>(_members.size());
+		}
+
+		int capacity() const noexcept { return _capacity; }
+
+		void clear()
+		{
+			std::lock_guard _{_mutex};
+			_members.clear();
+			_updateThreshold();
+		}
+
+	  private:
+
+		bool _isClose(const Solution &member, const Solution &solution) const
+		{
+			if constexpr (DistanceSolution<Solution>)
+				return member.distance(solution) < _minDistance;
+			else if constexpr (HashedSolution<Solution>)
+				return member.hash() == solution.hash();
+			else {
+				static_assert(EliteSolution<Solution>, "Algorithm::Storage::ElitePool: solution must provide distance(), hash() or equality comparison");
+				return member == solution;
+			}
+		}
+
+		//close members replaced by a better solution leave room in a full pool
+		void _updateThreshold() noexcept
+		{
+			const Fitness threshold{static_cast<int>(_members.size()) == _capacity ? _members.back()->fitness : Fitness::worst()};
+			_threshold.store(threshold - Fitness{0}, std::memory_order_relaxed);
+		}
+
+		const int _capacity;
+		const int _minDistance; //solutions closer than this are considered the same
+		std::vector<member_ptr_t> _members; //sorted by fitness, best first
+		std::atomic<Fitness::delta_t> _threshold{Fitness::worst() - Fitness{0}}; //fitness of the worst member once the pool is full
+		mutable std::mutex _mutex;
+	};
+
+} //ns Algorithm::Storage
+
+#endif //file guard
@@ -0,0 +1,11 @@
+#ifndef _algorithm_annealing_search_events_included_
+#define _algorithm_annealing_search_events_included_
+
+namespace Algorithm::Annealing::Events {
+
+	struct Tick {
+		double temperature;
+	};
+}
+
+#endif //file guard
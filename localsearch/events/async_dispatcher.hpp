@@ -0,0 +1,273 @@
+#ifndef _algorithm_events_async_dispatcher_included_
+#define _algorithm_events_async_dispatcher_included_
+
+#include "events.h"
+#include "../algorithm/bounded_queue.hpp"
+#include <ctoolhu/event/firer.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Algorithm::Events {
+
+	//Delivers the events published by the searchers (see publish) on its own thread, so that slow listeners (logging, persistence)
+	//don't stall the search. Once per window, or sooner if the queue fills up, the dispatcher fires all the events queued since the last delivery.
+	//Events carrying a solution are coalesced instead: the searcher hands over a copy of the solution and only the latest event of each type
+	//is delivered in the window, with the copy (so the listeners can't change the solution being searched).
+	//CurrentSolutionChanged, published on every step, is sampled rather than coalesced: once copied, the solution isn't copied again
+	//until the dispatcher takes the copy, so the searcher pays for one copy per window. The listeners get the first change of the window,
+	//and may miss the last changes of a search, whose result is carried by BestSolutionFound.
+	//Events are delivered in the order published, except the coalesced ones, which follow the queued ones of the same window.
+	//Only one dispatcher can run at a time. It must outlive the searches, and its listeners must not throw.
+	//While no dispatcher runs, the events are fired synchronously, as usual.
+	class AsyncDispatcher {
+
+	  public:
+
+		//what the searcher does when the queue is full
+		enum class Overflow {
+			block, //wait for the dispatcher to make room
+			drop //discard the event (see dropped)
+		};
+
+		explicit AsyncDispatcher(std::chrono::milliseconds window = std::chrono::milliseconds{100}, std::size_t capacity = 4096, Overflow overflow = Overflow::block)
+		:
+			_window{window},
+			_overflow{overflow},
+			_queue{capacity}
+		{
+			AsyncDispatcher *none{nullptr};
+			if (!_current.compare_exchange_strong(none, this, std::memory_order_acq_rel))
+				throw std::logic_error("Algorithm::Events::AsyncDispatcher: another dispatcher is already running");
+
+			_thread = std::thread{[this] { _dispatch(); }};
+		}
+
+		//delivers the remaining events
+		~AsyncDispatcher()
+		{
+			_current.store(nullptr, std::memory_order_release);
+			{
+				std::lock_guard _{_mutex};
+				_stopping = true;
+			}
+			_wake.notify_one();
+			_thread.join();
+		}
+
+		AsyncDispatcher(const AsyncDispatcher &) = delete;
+		AsyncDispatcher &operator=(const AsyncDispatcher &) = delete;
+
+		//number of events discarded because the queue was full
+		std::int64_t dropped() const noexcept { return _dropped.load(std::memory_order_relaxed); }
+
+	  private:
+
+		template <class Solution, class Event>
+		friend void publish(const Event &);
+
+		//queued event, copied into the envelope along with the function firing it
+		struct Envelope {
+			void (*fire)(const Envelope &) noexcept;
+			alignas(std::max_align_t) std::array<std::byte, 32> event;
+		};
+
+		class ISnapshot {
+
+		  public:
+
+			virtual ~ISnapshot() = default;
+			virtual void deliver() = 0;
+
+			std::atomic<std::uint64_t> generation{0}; //of the dispatcher the snapshot is registered with
+		};
+
+		//events of the type are only copied when the previous copy has been taken, see the class description
+		template <class Event>
+		static constexpr bool _isSampled{std::same_as<Event, CurrentSolutionChanged>};
+
+		//the latest event of its type carrying a solution, with the copy of the solution
+		template <class Solution, class Event>
+		class Snapshot final : public ISnapshot {
+
+		  public:
+
+			void store(const Event &event)
+			{
+				if constexpr (_isSampled<Event>) {
+					if (_isFresh.load(std::memory_order_acquire))
+						return; //the copy taken before is still to be delivered
+				}
+				auto const &solution = static_cast<const Solution &>(*event.solutionPtr);
+				std::lock_guard _{_mutex};
+				if (_pending)
+					*_pending = solution; //reuses the memory of the copy delivered before
+				else
+					_pending = std::make_unique<Solution>(solution);
+
+				_event = event;
+				_isFresh.store(true, std::memory_order_release);
+			}
+
+			void deliver() final
+			{
+				Event event;
+				{
+					std::lock_guard _{_mutex};
+					if (!_isFresh.load(std::memory_order_relaxed))
+						return;
+
+					std::swap(_pending, _delivered); //the searcher can store the next copy while the listeners read this one
+					event = _event;
+					_isFresh.store(false, std::memory_order_release);
+				}
+				event.solutionPtr = _delivered.get();
+				Ctoolhu::Event::Fire(event);
+			}
+
+		  private:
+
+			std::mutex _mutex;
+			std::unique_ptr<Solution> _pending;
+			std::unique_ptr<Solution> _delivered;
+			Event _event;
+			std::atomic<bool> _isFresh{false}; //a copy is waiting for delivery, read without the lock to skip the sampled copies
+		};
+
+		template <class Event>
+		void _enqueue(const Event &event)
+		{
+			static_assert(std::is_trivially_copyable_v<Event> && sizeof(Event) <= sizeof(Envelope::event) && alignof(Event) <= alignof(std::max_align_t),
+				"Algorithm::Events::AsyncDispatcher: queued events must be small and trivially copyable");
+
+			Envelope envelope;
+			envelope.fire = [](const Envelope &envelope) noexcept {
+				Event event;
+				std::memcpy(&event, envelope.event.data(), sizeof(Event));
+				Ctoolhu::Event::Fire(event);
+			};
+			std::memcpy(envelope.event.data(), &event, sizeof(Event));
+			while (!_queue.tryPush(envelope)) {
+				if (_overflow == Overflow::drop) {
+					_dropped.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+				_wake.notify_one();
+				std::this_thread::yield();
+			}
+		}
+
+		template <class Solution, class Event>
+		void _store(const Event &event)
+		{
+			static Snapshot<Solution, Event> snapshot; //shared by the dispatchers, one at a time
+			if (snapshot.generation.load(std::memory_order_acquire) != _generation) {
+				std::lock_guard _{_snapshotsMutex};
+				if (snapshot.generation.load(std::memory_order_relaxed) != _generation) {
+					_snapshots.push_back(&snapshot);
+					snapshot.generation.store(_generation, std::memory_order_release);
+				}
+			}
+			snapshot.store(event);
+		}
+
+		void _dispatch()
+		{
+			std::unique_lock lock{_mutex};
+			while (!_stopping) {
+				_wake.wait_for(lock, _window);
+				lock.unlock();
+				_deliver();
+				lock.lock();
+			}
+			lock.unlock();
+			_deliver();
+		}
+
+		void _deliver()
+		{
+			while (auto const envelope = _queue.tryPop())
+				envelope->fire(*envelope);
+
+			std::lock_guard _{_snapshotsMutex};
+			for (auto snapshot : _snapshots)
+				snapshot->deliver();
+		}
+
+		static inline std::atomic<AsyncDispatcher *> _current{nullptr};
+		static inline std::atomic<std::uint64_t> _generations{0};
+
+		const std::chrono::milliseconds _window;
+		const Overflow _overflow;
+		const std::uint64_t _generation{++_generations};
+		Private::BoundedQueue<Envelope> _queue;
+		std::atomic<std::int64_t> _dropped{0};
+		std::mutex _snapshotsMutex;
+		std::vector<ISnapshot *> _snapshots; //registered by the first event of their type
+		std::mutex _mutex;
+		std::condition_variable _wake;
+		bool _stopping{false};
+		std::thread _thread;
+	};
+
+	//Silences the progress events of the searchers on the current thread for the lifetime of the guard,
+	//i.e. the published ones (see publish) and the Started and Finished notifications,
+	//e.g. in the worker threads of a search that publishes only their merged result.
+	//The events fired synchronously for the listeners to react to the steps are not affected.
+	class Silenced {
+
+	  public:
+
+		Silenced() noexcept { ++_depth; }
+		~Silenced() { --_depth; }
+
+		Silenced(const Silenced &) = delete;
+		Silenced &operator=(const Silenced &) = delete;
+
+		static bool isActive() noexcept { return _depth > 0; }
+
+	  private:
+
+		static inline thread_local int _depth{0};
+	};
+
+	//Fires the event from the searcher, through the AsyncDispatcher if one is running.
+	//Events with a solution (solutionPtr) are coalesced and need a copyable solution type, otherwise they are fired synchronously.
+	//Use for events that only inform about the progress, the listeners of an event the searcher relies on (e.g. to adapt the fitness
+	//before the next step) must be called synchronously.
+	//Nothing is fired while the thread is silenced.
+	template <class Solution, class Event>
+	void publish(const Event &event)
+	{
+		if (Silenced::isActive())
+			return;
+
+		auto const dispatcher = AsyncDispatcher::_current.load(std::memory_order_acquire);
+		if (!dispatcher) {
+			Ctoolhu::Event::Fire(event);
+			return;
+		}
+		if constexpr (requires { event.solutionPtr; }) {
+			if constexpr (std::copyable<Solution>)
+				dispatcher->template _store<Solution>(event);
+			else
+				Ctoolhu::Event::Fire(event);
+		}
+		else
+			dispatcher->_enqueue(event);
+	}
+
+} //ns Algorithm::Events
+
+#endif //file guard
@@ -0,0 +1,62 @@
+#ifndef _algorithm_events_audience_included_
+#define _algorithm_events_audience_included_
+
+#include <ctoolhu/event/subscriber.hpp>
+#include <atomic>
+
+namespace Algorithm::Events {
+
+	template <class Event> class Subscriber;
+
+	//Keeps count of the subscribers of an event type, so that publishers can skip building payloads nobody would receive.
+	//Only the subscribers created through Events::Subscriber are counted, which is why the events gated by isHeard
+	//must be listened to through it: a plain Ctoolhu subscriber of such an event doesn't receive it.
+	template <class Event>
+	class Audience {
+
+	  public:
+
+		static bool isHeard() noexcept
+		{
+			return _listeners.load(std::memory_order_relaxed) != 0;
+		}
+
+	  private:
+
+		friend class Subscriber<Event>;
+
+		static void _join() noexcept
+		{
+			_listeners.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		static void _leave() noexcept
+		{
+			_listeners.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		static inline std::atomic<int> _listeners{0};
+	};
+
+	//Subscribes to an event type for the lifetime of the object and counts in its audience, use instead of Ctoolhu::Event::Subscriber
+	template <class Event>
+	class Subscriber : public Ctoolhu::Event::Subscriber<Event> {
+
+	  public:
+
+		Subscriber() noexcept { Audience<Event>::_join(); }
+		Subscriber(const Subscriber &other) noexcept : Ctoolhu::Event::Subscriber<Event>(other) { Audience<Event>::_join(); }
+		Subscriber &operator=(const Subscriber &) noexcept { return *this; }
+		~Subscriber() { Audience<Event>::_leave(); }
+	};
+
+	//returns false only if nobody listens to the event type, in which case it doesn't need to be fired at all
+	template <class Event>
+	bool isHeard() noexcept
+	{
+		return Audience<Event>::isHeard();
+	}
+
+} //ns Algorithm::Events
+
+#endif //file guard
@@ -0,0 +1,8 @@
+#ifndef _algorithm_late_acceptance_search_events_included_
+#define _algorithm_late_acceptance_search_events_included_
+
+namespace Algorithm::LateAcceptance::Events {
+	struct Tick {};
+}
+
+#endif //file guard
@@ -2,6 +2,8 @@
 #define _algorithm_tabu_search_events_included_
 
 #include <chrono>
+#include <ostream>
+#include <sstream>
 #include <string>
 
 namespace Algorithm {
@@ -10,6 +12,35 @@ namespace Algorithm {
 
 	namespace TabuSearch::Events {
 
+		//Describes a step on demand, so that the description is only rendered if a listener asks for it.
+		//Refers to the step, so it's only valid while the event carrying it is fired.
+		class StepView {
+
+		  public:
+
+			template <class Step>
+			explicit StepView(const Step &step) noexcept
+			:
+				_step{&step},
+				_dump{[](const void *step, std::ostream &out) { static_cast<const Step *>(step)->dump(out); }}
+			{
+			}
+
+			void dump(std::ostream &out) const { _dump(_step, out); }
+
+			std::string str() const
+			{
+				std::ostringstream s;
+				dump(s);
+				return s.str();
+			}
+
+		  private:
+
+			const void *_step;
+			void (*_dump)(const void *, std::ostream &);
+		};
+
 		struct Finished {
 			ISolution *currentSolutionPtr;
 			int executedSteps;
@@ -20,11 +51,12 @@ namespace Algorithm {
 			ISolution *currentSolutionPtr;
 		};
 
-		//executes after a single tabu search step is performed
+		//Executes after a single tabu search step is performed.
+		//The step is described after its execution, so steps must describe themselves from their own data, not the solution.
 		struct StepExecuted {
 			int dynamicAdaptationThreshold;
 			ISolution *currentSolutionPtr;
-			std::string stepDescription;
+			StepView step;
 			bool keepFeasible;
 		};
 
@@ -36,8 +68,10 @@ namespace Algorithm {
 			int size;
 		};
 
+		//The search returned to a solution it already visited in this run.
 		struct CycleDetected {
 			int stepsSinceLastImprovement;
+			int cycleLength; //steps since the solution was last visited, zero if only known to be the best solution
 		};
 
 	} //ns TabuSearch::Events
@@ -9,6 +9,10 @@
 
 namespace Algorithm {
 
+	namespace Private {
+		class ControlToken;
+	}
+
 	//This is a non-executable algorithm, but still useful, because it doesn't have to know the type of the solution
 	//but still provides access to useful operations.
 	//The rationale behind having this is to provide an interface to an algorithm that is already running.
@@ -32,6 +36,10 @@ namespace Algorithm {
 		virtual bool isStopRequested() const = 0;
 
 		virtual std::chrono::milliseconds elapsedTime() const = 0;
+
+		//Stop and pause state for quick checks by nested algorithms, null if the algorithm doesn't provide it.
+		//Not part of the public interface, internal to the algorithm implementations.
+		virtual const Private::ControlToken *controlToken() const noexcept { return nullptr; }
 	};
 
 } //ns Algorithm
@@ -0,0 +1,26 @@
+#ifndef _algorithm_icheckpointed_included_
+#define _algorithm_icheckpointed_included_
+
+namespace Algorithm {
+
+	namespace Checkpoint {
+		class Reader;
+		class Writer;
+	}
+
+	//Algorithms able to save the state they carry over from one run to the next (e.g. their random streams),
+	//so that a search can be resumed from a checkpoint as if it was never interrupted (see ChainedSearch).
+	//The state within a run is not saved, checkpoints are only taken between runs.
+	class ICheckpointed {
+
+	  public:
+
+		virtual ~ICheckpointed() = default;
+
+		virtual void saveState(Checkpoint::Writer &) const = 0;
+		virtual void loadState(Checkpoint::Reader &) = 0;
+	};
+
+} //ns Algorithm
+
+#endif //file guard
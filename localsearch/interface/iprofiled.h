@@ -0,0 +1,59 @@
+#ifndef _algorithm_iprofiled_included_
+#define _algorithm_iprofiled_included_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Algorithm {
+
+	//phases of the search measured by the profiling counters
+	enum class Phase {
+		neighborhood, //neighborhood evaluation (tabu search) or random walks (RNA search)
+		tabuCheck, //checks whether a candidate step is acceptable (count only, timed as part of the neighborhood evaluation)
+		aspiration, //candidate steps accepted by aspiration, without the tabu check (count only)
+		stepExecution,
+		bestCopy, //saving and restoring of the best solution
+		fitnessCheck, //verification of the fitness after a step
+		events, //event dispatch
+		count
+	};
+
+	//time spent in the search phases and number of times each phase was entered
+	struct Stats {
+
+		struct Counter {
+			std::int64_t count{0};
+			std::chrono::nanoseconds time{0};
+		};
+
+		Counter &operator[](Phase phase) noexcept { return phases[static_cast<std::size_t>(phase)]; }
+		const Counter &operator[](Phase phase) const noexcept { return phases[static_cast<std::size_t>(phase)]; }
+
+		Stats &operator+=(const Stats &other) noexcept
+		{
+			for (std::size_t i = 0; i < phases.size(); ++i) {
+				phases[i].count += other.phases[i].count;
+				phases[i].time += other.phases[i].time;
+			}
+			return *this;
+		}
+
+		std::array<Counter, static_cast<std::size_t>(Phase::count)> phases;
+	};
+
+	//Algorithms collecting profiling stats, when enabled by the "profile" config.
+	//Stats are accumulated over all runs of the algorithm.
+	class IProfiled {
+
+	  public:
+
+		virtual ~IProfiled() = default;
+
+		virtual Stats getStats() const = 0;
+	};
+
+} //ns Algorithm
+
+#endif //file guard
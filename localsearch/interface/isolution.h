@@ -6,9 +6,17 @@
 
 #include "../fitness.hpp"
 #include <boost/property_tree/ptree_fwd.hpp>
+#include <concepts>
+#include <cstdint>
+#include <span>
 
 namespace Algorithm {
 
+	namespace Checkpoint {
+		class Reader;
+		class Writer;
+	}
+
 	class ISolution {
 
 	  public:
@@ -33,6 +41,42 @@ namespace Algorithm {
 		ISolution() = default;
 	};
 
+	//Solutions usable by statically dispatched searchers.
+	//Make the concrete solution class final, so that calls to its methods don't go through the vtable.
+	template <class Solution>
+	concept SearchSolution = std::derived_from<Solution, ISolution> && std::copyable<Solution>;
+
+	//Solutions with a compact binary form for checkpoints, otherwise they are saved through the property tree.
+	//Loading must restore the same solution, including its fitness.
+	template <class Solution>
+	concept BinarySolution = requires(Solution &solution, const Solution &constSolution, Checkpoint::Writer &out, Checkpoint::Reader &in) {
+		constSolution.save(out);
+		solution.load(in);
+	};
+
+	//Solutions keeping a 64-bit hash of their structure, updated incrementally as the steps execute (e.g. by Zobrist hashing, see ZobristTable).
+	//Equal solutions must have equal hashes, so that the searchers can recognize a revisited solution in constant time.
+	//Different solutions sharing a hash are rare enough to be ignored, they only make the search report a cycle where there was none.
+	template <class Solution>
+	concept HashedSolution = requires(const Solution &solution) {
+		{ solution.hash() } -> std::same_as<std::uint64_t>;
+	};
+
+	//Solutions measuring how much they differ from another solution (e.g. the number of elements assigned differently),
+	//zero for equal solutions. Used to keep the solutions of an elite pool diverse (see Storage::ElitePool).
+	template <class Solution>
+	concept DistanceSolution = requires(const Solution &solution, const Solution &other) {
+		{ solution.distance(other) } -> std::convertible_to<int>;
+	};
+
+	//Solutions evaluating whole batches of compact move descriptors at once (see TabuSearch::MoveBatch).
+	//The deltas and adapted deltas of the moves are written to the contiguous arrays at the same positions,
+	//so that the evaluation can be a tight loop without allocation or virtual calls, e.g. a SIMD kernel.
+	template <class Solution, class Move>
+	concept BatchEvaluation = requires(const Solution &solution, std::span<const Move> moves, std::span<Fitness::delta_t> deltas, std::span<AdaptedFitness::delta_t> adaptedDeltas) {
+		solution.evaluate(moves, deltas, adaptedDeltas);
+	};
+
 } //ns Algorithm
 
 #endif
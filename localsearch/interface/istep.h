@@ -5,7 +5,9 @@
 #define _algorithm_istep_included_
 
 #include "../fitness.hpp"
+#include <concepts>
 #include <iosfwd>
+#include <vector>
 
 namespace Algorithm {
 
@@ -27,6 +29,31 @@ namespace Algorithm {
 		virtual void dump(std::ostream &) const = 0;
 	};
 
+	//Steps usable by statically dispatched searchers, which don't need to derive from IStep.
+	//Make the concrete step class final, so that calls to its methods don't go through the vtable even if it does derive from IStep.
+	template <class Step, class Solution>
+	concept SearchStep = requires(const Step &step, Solution &solution, std::ostream &os) {
+		{ step.adaptedDelta() } -> std::convertible_to<AdaptedFitness::delta_t>;
+		{ step.delta() } -> std::convertible_to<Fitness::delta_t>;
+		step.execute(solution);
+		step.dump(os);
+	};
+
+	//Steps which can revert their own execution, i.e. calling undo right after execute leaves the solution unchanged.
+	//Enables algorithms to roll back to a previous solution instead of keeping its copy.
+	template <class Step, class Solution>
+	concept UndoableStep = requires(const Step &step, Solution &solution) {
+		{ step.undo(solution) } -> std::same_as<void>;
+	};
+
+	//Optional extension of the step interface.
+	//Enables algorithms to cache the evaluation of the neighborhood and re-evaluate only its regions affected by the step.
+	//After execution, the step appends the regions (e.g. neighborhood partitions) whose steps it changed.
+	template <class Step, class Solution>
+	concept RegionalStep = requires(const Step &step, const Solution &solution, std::vector<int> &regions) {
+		step.touchedRegions(solution, regions);
+	};
+
 } //ns Algorithm
 
 #endif //file guard
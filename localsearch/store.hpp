@@ -1,12 +1,15 @@
 #ifndef _algorithm_store_included_
 #define _algorithm_store_included_
 
+#include "fitness.hpp"
 #include "interface/istore.h"
+#include <atomic>
 #include <memory>
 
 namespace Algorithm::Storage {
 
 	//Thread-safe storage for solutions
+	//Keeps several full copies of the solution, which cost only their changed parts if the solution stores its data in SegmentedArrays.
 	template <class Solution>
 	class Store : public IStore {
 
@@ -14,6 +17,15 @@ namespace Algorithm::Storage {
 
 		using locked_t = Ctoolhu::Thread::LockingProxy<Store<Solution>>;
 
+		//immutable copy of a solution, published for readers which must not block the algorithm
+		struct Snapshot {
+			Solution solution;
+			Fitness fitness; //fitness at the time of publication (the solution can't be asked, as it might evaluate lazily)
+			bool feasible;
+		};
+
+		using snapshot_ptr_t = std::shared_ptr<const Snapshot>;
+
 		//point current solution to given solution, also init best solution
 		explicit Store(const std::shared_ptr<Solution> &solution)
 		:	_currentSolution{solution},
@@ -57,6 +69,37 @@ namespace Algorithm::Storage {
 			}
 		}
 
+		//Alternative to setBestSolution, meant for publishing progress to readers polling from other threads.
+		//Copies the current solution to an immutable snapshot and swaps the pointer to it in atomically,
+		//so the readers of snapshots don't lock the store and never wait for a solution being copied.
+		//The swap itself may take a short internal lock, std::atomic<std::shared_ptr> isn't lock-free in the common standard libraries.
+		//Reads the current solution, so it must be called by the only thread working on it, or under the store's lock (see lockStore).
+		void publishBestSnapshot()
+		{
+			auto const snapshot = _makeSnapshot();
+			_bestSnapshot.store(snapshot);
+			_publishOverall(_bestOverallSnapshot, snapshot, [](const Snapshot &candidate, const Snapshot &published) {
+				return candidate.fitness < published.fitness;
+			});
+		}
+
+		//alternative to setFeasibleSolution, see publishBestSnapshot
+		void publishFeasibleSnapshot()
+		{
+			auto const snapshot = _makeSnapshot();
+			_feasibleSnapshot.store(snapshot);
+			_publishOverall(_feasibleOverallSnapshot, snapshot, [](const Snapshot &candidate, const Snapshot &published) {
+				return !published.feasible || candidate.fitness < published.fitness;
+			});
+		}
+
+		//Published snapshots can be read without locking the store, null if nothing has been published yet.
+		//Unlike the stored solutions, snapshots are not affected by markDirty, their fitness is the one at the time of publication.
+		snapshot_ptr_t getBestSnapshot() const noexcept { return _bestSnapshot.load(); }
+		snapshot_ptr_t getFeasibleSnapshot() const noexcept { return _feasibleSnapshot.load(); }
+		snapshot_ptr_t getBestOverallSnapshot() const noexcept { return _bestOverallSnapshot.load(); }
+		snapshot_ptr_t getFeasibleOverallSnapshot() const noexcept { return _feasibleOverallSnapshot.load(); }
+
 		//invalidate fitness and feasibility status of all stored solutions
 		void markDirty() final
 		{
@@ -74,12 +117,32 @@ namespace Algorithm::Storage {
 
 	  private:
 
+		snapshot_ptr_t _makeSnapshot() const
+		{
+			const Fitness fitness{_currentSolution->getFitness()};
+			const bool feasible{_currentSolution->isFeasible()};
+			return std::make_shared<const Snapshot>(Snapshot{*_currentSolution, fitness, feasible});
+		}
+
+		//replaces the published overall snapshot if the candidate is better
+		template <class Better>
+		static void _publishOverall(std::atomic<snapshot_ptr_t> &overall, const snapshot_ptr_t &candidate, Better better)
+		{
+			if (auto const published = overall.load(); !published || better(*candidate, *published))
+				overall.store(candidate);
+		}
+
 		const std::shared_ptr<Solution> _currentSolution;	//solution currently worked upon by the algorithm
 		const std::unique_ptr<Solution> _bestSolution;		//best solution found by the algorithm
 		std::unique_ptr<Solution> _feasibleSolution;		//best feasible solution found by the algorithm
 
 		const std::unique_ptr<Solution> _bestOverallSolution;//best overall solution found during the lifetime of the store (can be dirty)
 		std::unique_ptr<Solution> _feasibleOverallSolution;	//best overall feasible solution found during the lifetime of the store (can be dirty)
+
+		std::atomic<snapshot_ptr_t> _bestSnapshot;
+		std::atomic<snapshot_ptr_t> _feasibleSnapshot;
+		std::atomic<snapshot_ptr_t> _bestOverallSnapshot;
+		std::atomic<snapshot_ptr_t> _feasibleOverallSnapshot;
 	};
 
 	//returns a locked store (given as parameter) that can be used thread-safely